@@ -0,0 +1,134 @@
+/**
+ * @file bench_numbers.cpp
+ * @brief Benchmark of the number parsing and formatting helpers.
+ *
+ * Compares the legacy std::stoi/std::stod/std::stof path (exceptions on malformed input)
+ * with the non-throwing parseNumber()/formatNumber() helpers on values as they appear
+ * in the sensor update frames.
+ *
+ * Build and run on host (from the repository root):
+ *   g++ -std=c++17 -O2 -DSTDIO_H -Ilibraries/engine benchmarks/bench_numbers.cpp \
+ *       libraries/engine/helpers.cpp libraries/engine/logs.cpp -o bench_numbers
+ *   ./bench_numbers
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#include "helpers.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Legacy conversion, as used by convertStringToType before the parse helpers.
+ */
+template <typename T>
+static T legacyConvert(const std::string &str);
+
+template <>
+int legacyConvert<int>(const std::string &str) {
+    try {
+        return std::stoi(str);
+    }
+    catch(const std::exception &e) {
+        throw InvalidDataTypeException("legacyConvert<int>", str + " is non-int format string!");
+    }
+}
+
+template <>
+double legacyConvert<double>(const std::string &str) {
+    try {
+        return std::stod(str);
+    }
+    catch(const std::exception &e) {
+        throw InvalidDataTypeException("legacyConvert<double>", str + " is non-double format string!");
+    }
+}
+
+/**
+ * @brief Values of realistic update frames (see emulator/emulator.py).
+ */
+static const std::vector<std::string> INT_VALUES = {
+    "132", "27", "-14", "7", "19", "88", "41", "0", "1", "1013", "56", "42", "73", "1"
+};
+static const std::vector<std::string> DOUBLE_VALUES = {
+    "27.4", "-0.57", "12.87", "0.42", "1013.25", "3.5", "22.1", "14.06", "-9.81", "0.01"
+};
+static const std::vector<std::string> MALFORMED_VALUES = {
+    "2\x7f", "x13", "", "1.2.3", "--5", "\xff\xfe", "12a", "e5"
+};
+
+/**
+ * @brief Run the function over all values and report nanoseconds per value.
+ */
+template <typename F>
+static void run(const char *name, const std::vector<std::string> &values, F &&convert) {
+    const int rounds = 20000;
+    volatile double sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for(int r = 0; r < rounds; ++r) {
+        for(const std::string &value : values) {
+            sink = sink + convert(value);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    printf("%-34s %8.1f ns/value\n", name, ns / (rounds * values.size()));
+}
+
+int main() {
+    printf("Parsing valid values:\n");
+    run("  legacy int (std::stoi)", INT_VALUES, [](const std::string &s) {
+        return legacyConvert<int>(s);
+    });
+    run("  parseNumber int", INT_VALUES, [](const std::string &s) {
+        int value = 0;
+        parseNumber(s, value);
+        return value;
+    });
+    run("  legacy double (std::stod)", DOUBLE_VALUES, [](const std::string &s) {
+        return legacyConvert<double>(s);
+    });
+    run("  parseNumber double", DOUBLE_VALUES, [](const std::string &s) {
+        double value = 0;
+        parseNumber(s, value);
+        return value;
+    });
+
+    printf("Parsing malformed values:\n");
+    run("  legacy double (exception)", MALFORMED_VALUES, [](const std::string &s) {
+        try {
+            return legacyConvert<double>(s);
+        }
+        catch(const Exception &e) {
+            return 0.0;
+        }
+    });
+    run("  parseNumber double (status)", MALFORMED_VALUES, [](const std::string &s) {
+        double value = 0;
+        return parseNumber(s, value) == ParseStatus::OK ? value : 0.0;
+    });
+
+    printf("Formatting values:\n");
+    std::vector<double> numbers;
+    for(const std::string &value : DOUBLE_VALUES) {
+        numbers.push_back(std::stod(value));
+    }
+    run("  snprintf %g", DOUBLE_VALUES, [&numbers](const std::string &/*s*/) {
+        static size_t i = 0;
+        char buffer[32];
+        return snprintf(buffer, sizeof(buffer), "%g", numbers[i++ % numbers.size()]);
+    });
+    run("  formatNumber double", DOUBLE_VALUES, [&numbers](const std::string &/*s*/) {
+        static size_t i = 0;
+        char buffer[32];
+        return static_cast<int>(formatNumber(buffer, sizeof(buffer), numbers[i++ % numbers.size()]));
+    });
+
+    return 0;
+}
@@ -0,0 +1,421 @@
+/**
+ * @file bench_parser.cpp
+ * @brief Throughput benchmark of the update frame receive path.
+ *
+ * Feeds batches of update frames, shaped like the ones emulator/emulator.py pushes on the
+ * serial line, through the stages of SensorManager::resync(): frame splitting, metadata
+ * parsing and the sensor update, in the text and in the binary format. Every stage reports frames per second and heap
+ * allocations per frame, counted by replacing the global operator new. The outbound requests built
+ * by FrameBuilder, the UID lookup of a large fleet and the typed update queue of the threaded
+ * mode are measured the same way.
+ *
+ * Build and run on host (from the repository root):
+ *   g++ -std=c++17 -O2 -DSTDIO_H -DLV_CONF_INCLUDE_SIMPLE -Ilibraries -Ilibraries/lvgl \
+ *       -Ilibraries/engine -Ibenchmarks benchmarks/bench_parser.cpp \
+ *       libraries/engine/base_sensor.cpp libraries/engine/coalescer.cpp libraries/engine/exceptions.cpp \
+ *       libraries/engine/frame_check.cpp libraries/engine/helpers.cpp libraries/engine/logs.cpp \
+ *       libraries/engine/messenger.cpp libraries/engine/parser.cpp \
+ *       libraries/engine/transport.cpp -o bench_parser
+ *   ./bench_parser
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#include "headless_sensor.hpp"
+#include "frame_assembler.hpp"
+#include "frame_builder.hpp"
+#include "frame_check.hpp"
+#include "sensor_index.hpp"
+#include "ring_buffer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Heap allocation counters, fed by the replaced global operator new.
+ */
+static size_t AllocationCount = 0;
+static size_t AllocationBytes = 0;
+
+// GCC pairs the inlined malloc()/free() bodies with the call sites of new/delete
+// and reports them as mismatched, the replacements below are consistent.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void* operator new(size_t size) {
+    ++AllocationCount;
+    AllocationBytes += size;
+    void *ptr = std::malloc(size ? size : 1);
+    if(!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+#pragma GCC diagnostic pop
+
+/**
+ * @brief Build batches of update frames like emulator.py, keys follow the sensor schemas.
+ */
+static std::vector<std::string> makeBatches(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    auto integer = [&rng](int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(rng); };
+    auto real = [&rng](double lo, double hi) { return std::uniform_real_distribution<double>(lo, hi)(rng); };
+
+    std::vector<std::string> batches;
+    char buffer[512];
+    for(size_t i = 0; i < count; ++i) {
+        snprintf(buffer, sizeof(buffer),
+                 "?id=3&dist=%d "
+                 "?id=4&Temperature=%d&acm_x=%d&acm_y=%d&acm_z=%d&gyr_x=%d&gyr_y=%d&gyr_z=%.2f "
+                 "?id=5&Temperature=%d&Pressure=%d "
+                 "?id=7&XCoordination=%d&YCoordination=%d&Button=%d "
+                 "?id=8&Temperature=%.1f&Humidity=%d "
+                 "?id=9&milliTesla Meter=%.2f&Magnet Detector=%d "
+                 "?id=10&Lux=%d\n",
+                 integer(50, 200),
+                 integer(20, 35), integer(-20, 20), integer(-20, 20), integer(-20, 20),
+                 integer(0, 100), integer(0, 100), real(0, 1),
+                 integer(20, 35), integer(950, 1050),
+                 integer(0, 100), integer(0, 100), integer(0, 1),
+                 real(20, 30), integer(30, 90),
+                 real(10, 15), integer(0, 1),
+                 integer(50, 200));
+        batches.push_back(buffer);
+    }
+    return batches;
+}
+
+/**
+ * @brief Append binary frame of the values, given in the schema order.
+ */
+template <size_t N>
+static void appendBinaryFrame(std::string &batch, const char *uid, const std::array<FieldSchema, N> &schema,
+                              const std::array<double, N> &values) {
+    std::string payload(1, static_cast<char>(strlen(uid)));
+    payload += uid;
+    for(size_t i = 0; i < N; ++i) {
+        uint32_t word;
+        if(schema[i].DType == DataType::INT) {
+            word = static_cast<uint32_t>(static_cast<int32_t>(values[i]));
+        }
+        else {
+            float real = static_cast<float>(values[i]);
+            memcpy(&word, &real, sizeof(word));
+        }
+        char field[BINARY_FIELD_SIZE];
+        field[0] = static_cast<char>(i);
+        writeUint32LE(field + 1, word);
+        payload.append(field, sizeof(field));
+    }
+    batch += BINARY_FRAME_MARKER;
+    batch += static_cast<char>(payload.size());
+    batch += payload;
+}
+
+/**
+ * @brief Build the same batches as makeBatches() in the binary format.
+ */
+static std::vector<std::string> makeBinaryBatches(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    auto integer = [&rng](int lo, int hi) { return static_cast<double>(std::uniform_int_distribution<int>(lo, hi)(rng)); };
+    auto real = [&rng](double lo, double hi) { return std::uniform_real_distribution<double>(lo, hi)(rng); };
+
+    std::vector<std::string> batches;
+    for(size_t i = 0; i < count; ++i) {
+        std::string batch;
+        // Arguments are drawn in the order of makeBatches(), so the values are the same.
+        double dist = integer(50, 200);
+        appendBinaryFrame(batch, "3", TOFSchema::Values, {dist});
+        double temperature = integer(20, 35), acmX = integer(-20, 20), acmY = integer(-20, 20), acmZ = integer(-20, 20);
+        double gyrX = integer(0, 100), gyrY = integer(0, 100), gyrZ = real(0, 1);
+        appendBinaryFrame(batch, "4", GATSchema::Values, {temperature, acmX, acmY, acmZ, gyrX, gyrY, gyrZ});
+        temperature = integer(20, 35);
+        double pressure = integer(950, 1050);
+        appendBinaryFrame(batch, "5", TPSchema::Values, {temperature, pressure});
+        double x = integer(0, 100), y = integer(0, 100), button = integer(0, 1);
+        appendBinaryFrame(batch, "7", JoystickSchema::Values, {x, y, button});
+        temperature = real(20, 30);
+        double humidity = integer(30, 90);
+        appendBinaryFrame(batch, "8", DHT11Schema::Values, {temperature, humidity});
+        double milliTesla = real(10, 15), magnet = integer(0, 1);
+        appendBinaryFrame(batch, "9", LinearHallAndDigitalSchema::Values, {milliTesla, magnet});
+        double lux = integer(50, 200);
+        appendBinaryFrame(batch, "10", PhotoResistorSchema::Values, {lux});
+        batches.push_back(batch);
+    }
+    return batches;
+}
+
+/**
+ * @brief Wrap every frame of the text batches into a checked frame.
+ */
+static std::vector<std::string> makeCheckedBatches(const std::vector<std::string> &batches) {
+    std::vector<std::string> checked;
+    uint8_t seq = 0;
+    for(const std::string &batch : batches) {
+        std::string line;
+        forEachWireFrame(batch, WireFormat::TEXT, [&line, &seq](std::string_view frame, WireFormat) {
+            std::string payload = "?" + std::string(frame);
+            appendCheckedFrame(line, payload, seq++);
+        });
+        checked.push_back(line);
+    }
+    return checked;
+}
+
+/**
+ * @brief Average size of the batches in bytes.
+ */
+static double averageSize(const std::vector<std::string> &batches) {
+    size_t bytes = 0;
+    for(const std::string &batch : batches) {
+        bytes += batch.size();
+    }
+    return batches.empty() ? 0.0 : static_cast<double>(bytes) / batches.size();
+}
+
+/**
+ * @brief Build batches of random bytes, as seen on a noisy serial line.
+ */
+static std::vector<std::string> makeGarbage(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    const char alphabet[] = "?&=id0123456789.-eE \r\nxyzTL";
+    std::vector<std::string> batches;
+    for(size_t i = 0; i < count; ++i) {
+        std::string batch(256, '\0');
+        for(char &c : batch) {
+            c = rng() % 4 ? alphabet[rng() % (sizeof(alphabet) - 1)] : static_cast<char>(rng());
+        }
+        batches.push_back(batch);
+    }
+    return batches;
+}
+
+/**
+ * @brief Run the stage over all batches and report frames/sec and allocations/frame.
+ *
+ * @param stage Callable returning the number of frames processed in a batch.
+ */
+template <typename F>
+static void run(const char *name, const std::vector<std::string> &batches, F &&stage) {
+    const int rounds = 200;
+    size_t frames = 0;
+
+    size_t allocations = AllocationCount;
+    size_t bytes = AllocationBytes;
+    auto start = std::chrono::steady_clock::now();
+    for(int r = 0; r < rounds; ++r) {
+        for(const std::string &batch : batches) {
+            frames += stage(batch);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    allocations = AllocationCount - allocations;
+    bytes = AllocationBytes - bytes;
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double perFrame = frames ? 1.0 / frames : 0.0;
+    printf("%-34s %12.0f frames/s %8.1f ns/frame %6.2f allocs/frame %8.1f B/frame\n",
+           name, frames / seconds, seconds * 1e9 * perFrame, allocations * perFrame, bytes * perFrame);
+}
+
+int main() {
+    std::vector<std::string> batches = makeBatches(256, 1);
+    std::vector<std::string> binary = makeBinaryBatches(256, 1);
+    std::vector<std::string> garbage = makeGarbage(256, 2);
+    std::vector<BaseSensor*> sensors;
+    createHeadlessSensorList(sensors);
+
+    printf("Emulator-like text batches (7 frames, %.0f bytes each):\n", averageSize(batches));
+    run("  split (forEachWireFrame)", batches, [](const std::string &batch) {
+        return forEachWireFrame(batch, WireFormat::TEXT, [](std::string_view, WireFormat) {});
+    });
+    static RingBuffer<char, UART_RX_BUFFER> ring;
+    static FrameAssembler<UART_FRAME_MAX> assembler(FRAME_DELIMITER);
+    run("  receive (ring buffer + assembly)", batches, [](const std::string &batch) {
+        std::string_view line;
+        ring.write(batch.data(), batch.size());
+        while (assembler.poll(ring, line)) {}
+        return static_cast<size_t>(7); // One line of 7 frames.
+    });
+    run("  split + ParseMetadata", batches, [](const std::string &batch) {
+        size_t valid = 0;
+        forEachWireFrame(batch, WireFormat::TEXT, [&valid](std::string_view frame, WireFormat) {
+            SensorMetadata metadata = ParseMetadata(frame, true);
+            valid += CheckMetadata(&metadata);
+        });
+        return valid;
+    });
+    run("  full update, case-sensitive", batches, [&sensors](const std::string &batch) {
+        return ingestFrames(sensors, batch, WireFormat::TEXT, true);
+    });
+
+    for(BaseSensor *sensor : sensors) {
+        sensor->setCaseSensitive(false);
+    }
+    run("  full update, case-insensitive", batches, [&sensors](const std::string &batch) {
+        return ingestFrames(sensors, batch, WireFormat::TEXT, false);
+    });
+    static UpdateCoalescer coalescer;
+    coalescer.setEnabled(true); // Independent of COALESCE_SYNC.
+    size_t burst = 0;
+    run("  coalesced, 10 batches per resync", batches, [&sensors, &burst](const std::string &batch) {
+        size_t frames = ingestFrames(sensors, batch, WireFormat::TEXT, false, &coalescer);
+        if (++burst % 10 == 0) {
+            coalescer.flush();
+        }
+        return frames;
+    });
+
+    printf("Threaded mode, typed updates through the queue:\n");
+    static UpdateQueue updates;
+    run("  parse + queue + apply, one thread", batches, [&sensors](const std::string &batch) {
+        size_t frames = publishFrames(sensors, batch, WireFormat::TEXT, updates);
+        SensorUpdate update;
+        while (updates.pop(update)) {
+            update.Sensor->applyUpdate(update);
+        }
+        return frames;
+    });
+    std::atomic<bool> reading(true);
+    std::thread reader([&reading]() {
+        SensorUpdate update;
+        while (reading || !updates.empty()) {
+            while (updates.pop(update)) {
+                update.Sensor->applyUpdate(update);
+            }
+            std::this_thread::yield();
+        }
+    });
+    run("  parse + queue, reader thread", batches, [&sensors](const std::string &batch) {
+        return publishFrames(sensors, batch, WireFormat::TEXT, updates);
+    });
+    reading = false;
+    reader.join();
+
+    std::vector<std::string> checked = makeCheckedBatches(batches);
+    printf("Checked text batches (7 frames, %.0f bytes each):\n", averageSize(checked));
+    static FrameChecker checker;
+    run("  split + CRC check", checked, [](const std::string &batch) {
+        return checker.forEach(batch, WireFormat::TEXT, [](std::string_view, WireFormat) {});
+    });
+    run("  full update", checked, [&sensors](const std::string &batch) {
+        size_t frames = 0;
+        checker.forEach(batch, WireFormat::TEXT, [&sensors, &frames](std::string_view frame, WireFormat format) {
+            frames += ingestFrames(sensors, format == WireFormat::TEXT ? frame : std::string_view(), WireFormat::TEXT, false);
+        });
+        return frames;
+    });
+
+    printf("Binary batches (7 frames, %.0f bytes each):\n", averageSize(binary));
+    run("  split (forEachWireFrame)", binary, [](const std::string &batch) {
+        return forEachWireFrame(batch, WireFormat::BINARY, [](std::string_view, WireFormat) {});
+    });
+    run("  full update", binary, [&sensors](const std::string &batch) {
+        return ingestFrames(sensors, batch, WireFormat::BINARY, false);
+    });
+
+    printf("Garbage batches (%zu bytes each):\n", garbage.front().size());
+    run("  split + ParseMetadata", garbage, [](const std::string &batch) {
+        return forEachWireFrame(batch, WireFormat::BINARY, [](std::string_view frame, WireFormat format) {
+            SensorMetadata metadata = format == WireFormat::BINARY ? ParseBinaryMetadata(frame) : ParseMetadata(frame, true);
+            (void)metadata;
+        });
+    });
+    run("  full update", garbage, [&sensors](const std::string &batch) {
+        return ingestFrames(sensors, batch, WireFormat::BINARY, false);
+    });
+
+    printf("Outbound requests (one per sensor):\n");
+    static FrameBuilder request;
+    static size_t requestBytes = 0;
+    run("  build ?UPDATE&id=..&req=..", batches, [&sensors](const std::string &) {
+        for(BaseSensor *sensor : sensors) {
+            request.command("UPDATE").field("id", sensor->UID).field("req", static_cast<int>(requestBytes & 0xFFFF));
+            requestBytes += request.size();
+        }
+        return sensors.size();
+    });
+    run("  build ?CONFIG with values", batches, [&sensors](const std::string &) {
+        for(BaseSensor *sensor : sensors) {
+            request.command("CONFIG").field("id", sensor->UID).field("period", 250).field("offset", -1.25);
+            requestBytes += request.size();
+        }
+        return sensors.size();
+    });
+
+    std::vector<BaseSensor*> fleet;
+    SensorIndex index;
+    for(int i = 0; i < 256; ++i) {
+        fleet.push_back(new HeadlessSensor<TOFSchema>(std::to_string(i), "TOF"));
+        index.insert(fleet.back()->UID, fleet.back());
+    }
+    std::vector<std::string> uids;
+    std::mt19937 rng(3);
+    for(int i = 0; i < 64; ++i) {
+        uids.push_back(std::to_string(rng() % 256));
+    }
+    static size_t found = 0; // Kept, so the lookups are not optimized out.
+    printf("UID lookup among %zu sensors (64 frames):\n", fleet.size());
+    run("  linear scan", batches, [&fleet, &uids](const std::string &) {
+        for(const std::string &uid : uids) {
+            for(BaseSensor *sensor : fleet) {
+                if(sensor->UID == uid) {
+                    found += sensor->UID.size();
+                    break;
+                }
+            }
+        }
+        return uids.size();
+    });
+    run("  SensorIndex", batches, [&index, &uids](const std::string &) {
+        for(const std::string &uid : uids) {
+            found += index.find(uid)->UID.size();
+        }
+        return uids.size();
+    });
+    for(BaseSensor *sensor : fleet) {
+        delete sensor;
+    }
+    printf("Found UID bytes: %zu\n", found);
+
+    unsigned long rejected = 0;
+    for(BaseSensor *sensor : sensors) {
+        rejected += sensor->RejectedValues;
+        delete sensor;
+    }
+    printf("Rejected values: %lu\n", rejected);
+
+    return 0;
+}
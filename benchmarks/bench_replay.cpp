@@ -0,0 +1,119 @@
+/**
+ * @file bench_replay.cpp
+ * @brief Replay of recorded traffic through the receive path, and its recording.
+ *
+ * Replays a recording (see recording.hpp) through the messenger and the sensors, the same
+ * way SensorManager::resync() polls and ingests it, and reports the frame rate and the time
+ * spent in ingesting. Run as fast as possible (speed 0) it is a repeatable load test of
+ * the receive path, run at the original speed it shows whether the engine keeps up.
+ *
+ * Record the device output read from stdin (e.g. the serial port of the device or of
+ * emulator.py) with --record, the arrival times of the bytes are kept.
+ *
+ * Build and run on host (from the repository root):
+ *   g++ -std=c++17 -O2 -DSTDIO_H -DLV_CONF_INCLUDE_SIMPLE -Ilibraries -Ilibraries/lvgl \
+ *       -Ilibraries/engine -Ibenchmarks benchmarks/bench_replay.cpp \
+ *       libraries/engine/base_sensor.cpp libraries/engine/coalescer.cpp libraries/engine/exceptions.cpp \
+ *       libraries/engine/frame_check.cpp libraries/engine/helpers.cpp libraries/engine/logs.cpp \
+ *       libraries/engine/messenger.cpp libraries/engine/parser.cpp \
+ *       libraries/engine/recording.cpp libraries/engine/transport.cpp -o bench_replay -lpthread
+ *   stty -F /dev/ttyUSB0 115200 raw && ./bench_replay --record capture.bin 10 < /dev/ttyUSB0
+ *   ./bench_replay capture.bin 0
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#include "headless_sensor.hpp"
+#include "messenger.hpp"
+#include "recording.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Record standard input for the given number of seconds.
+ */
+static int record(const char *path, double seconds) {
+    StdioTransport input;
+    RecordingTransport recorder(input, path);
+    if (!recorder.begin()) {
+        return 1;
+    }
+    char chunk[256];
+    auto end = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+    while (std::chrono::steady_clock::now() < end) {
+        if (recorder.receive(chunk, sizeof(chunk)) == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    recorder.close();
+    printf("Recorded %zu records (%lu bytes) to %s\n", recorder.records(), recorder.stats().BytesReceived, path);
+    return 0;
+}
+
+/**
+ * @brief Replay the recording through the headless sensors.
+ */
+static int replay(const char *path, double speed) {
+    ReplayTransport player(path, speed);
+    Messenger messenger(&player);
+    if (!messenger.begin()) {
+        return 1;
+    }
+
+    std::vector<BaseSensor*> sensors;
+    createHeadlessSensorList(sensors);
+
+    size_t batches = 0;
+    size_t frames = 0;
+    std::chrono::nanoseconds ingestTime(0);
+    auto start = std::chrono::steady_clock::now();
+    std::string_view batch;
+    for (;;) {
+        if (!messenger.poll(batch)) {
+            if (player.finished()) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+        auto begin = std::chrono::steady_clock::now();
+        frames += ingestFrames(sensors, batch, BINARY_SYNC ? WireFormat::BINARY : WireFormat::TEXT, CASE_SENSITIVE_SYNC);
+        ingestTime += std::chrono::steady_clock::now() - begin;
+        ++batches;
+    }
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double recorded = player.position() / 1e6;
+
+    printf("Replay of %s at speed %g:\n", path, speed);
+    printf("  recorded %10.3f s, replayed %10.3f s\n", recorded, wall);
+    printf("  batches %10zu, frames %10zu, overflows %zu\n", batches, frames, messenger.overflows());
+    if (frames > 0) {
+        printf("  %12.0f frames/s replayed, %8.1f ns/frame ingest\n",
+               frames / wall, static_cast<double>(ingestTime.count()) / frames);
+    }
+
+    for (BaseSensor *sensor : sensors) {
+        delete sensor;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc >= 3 && strcmp(argv[1], "--record") == 0) {
+        return record(argv[2], argc > 3 ? atof(argv[3]) : 10.0);
+    }
+    if (argc >= 2) {
+        return replay(argv[1], argc > 2 ? atof(argv[2]) : 0.0);
+    }
+    printf("Usage: %s <recording> [speed, 0 as fast as possible]\n"
+           "       %s --record <recording> [seconds] < device output\n", argv[0], argv[0]);
+    return 1;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file headless_sensor.hpp
+ * @brief Sensors without GUI for the host-side benchmark and fuzzing targets.
+ *
+ * The sensors share the field schemas of the real sensor classes, so the whole
+ * receive path (frame splitting, metadata parsing, schema lookup, value parsing and
+ * history) runs exactly as on the device, only drawing is left out. LVGL headers are
+ * needed for compilation, no LVGL object is created or linked.
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#ifndef HEADLESS_SENSOR_HPP
+#define HEADLESS_SENSOR_HPP
+
+#include "base_sensor.hpp"
+#include "coalescer.hpp"
+#include "sensor_schemas.hpp"
+
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * @class HeadlessSensor
+ * @brief Sensor of the given schema with no-op GUI methods.
+ *
+ * @tparam Schema The sensor field schema.
+ */
+template <typename Schema>
+class HeadlessSensor : public SchemaSensor<Schema>
+{
+public:
+    HeadlessSensor(std::string uid, const char *type) : SchemaSensor<Schema>(uid)
+    {
+        this->Type = type;
+    }
+
+    void init() override {}
+    void draw() override { this->redrawPenging = false; }
+    void construct() override {}
+    void show() override {}
+    void hide() override {}
+    void destruct(bool) override {}
+};
+
+/**
+ * @brief Create headless sensors with the UIDs used by emulator/emulator.py.
+ *
+ * @param memory The list of sensors, owned by the caller.
+ */
+inline void createHeadlessSensorList(std::vector<BaseSensor*> &memory)
+{
+    memory.clear();
+    memory.push_back(new HeadlessSensor<TOFSchema>("3", "TOF"));
+    memory.push_back(new HeadlessSensor<GATSchema>("4", "GAT"));
+    memory.push_back(new HeadlessSensor<TPSchema>("5", "TP"));
+    memory.push_back(new HeadlessSensor<JoystickSchema>("7", "Joystick"));
+    memory.push_back(new HeadlessSensor<DHT11Schema>("8", "DHT11"));
+    memory.push_back(new HeadlessSensor<LinearHallAndDigitalSchema>("9", "LinearHallAndDigital"));
+    memory.push_back(new HeadlessSensor<PhotoResistorSchema>("10", "PhotoResistor"));
+}
+
+/**
+ * @brief Dispatch batched update frames to the sensors.
+ *
+ * Mirrors the receive path of SensorManager::ingest(), without the manager singleton
+ * and its messenger.
+ *
+ * @param memory The list of sensors.
+ * @param batch The received batch of text and binary frames (e.g. "?id=3&dist=120?id=10&Lux=80").
+ * @param format The negotiated format, binary frames are split only on a BINARY link.
+ * @param caseSensitive Flag if keys are matched case-sensitive.
+ * @param coalescer The coalescing stage the frames are queued to, nullptr applies them at once.
+ * @return The number of frames in the batch.
+ */
+inline size_t ingestFrames(std::vector<BaseSensor*> &memory, std::string_view batch, WireFormat format,
+                           bool caseSensitive, UpdateCoalescer *coalescer = nullptr)
+{
+    return forEachWireFrame(batch, format, [&](std::string_view frame, WireFormat format) {
+        SensorMetadata metadata = format == WireFormat::BINARY ? ParseBinaryMetadata(frame)
+                                                               : ParseMetadata(frame, caseSensitive);
+        if (!CheckMetadata(&metadata)) {
+            return;
+        }
+        for (BaseSensor *sensor : memory) {
+            if (sensor->UID == metadata.UID) {
+                if (coalescer) {
+                    coalescer->push(sensor, metadata);
+                } else {
+                    updateSensor(sensor, metadata.Data, metadata.Format);
+                }
+                return;
+            }
+        }
+    });
+}
+
+/**
+ * @brief Parse batched update frames into typed updates, as the communication task does.
+ *
+ * Mirrors BusShard::publish() in threaded mode, the values are applied by the reader of
+ * the queue (BaseSensor::applyUpdate). Unlike BusShard, which drops on a full queue, it waits
+ * for the reader here, so every measured update is applied.
+ *
+ * @param memory The list of sensors.
+ * @param batch The received batch of text and binary frames.
+ * @param format The negotiated format, binary frames are split only on a BINARY link.
+ * @param queue The queue of the updates.
+ * @return The number of frames in the batch.
+ */
+inline size_t publishFrames(std::vector<BaseSensor*> &memory, std::string_view batch, WireFormat format,
+                            UpdateQueue &queue)
+{
+    return forEachWireFrame(batch, format, [&](std::string_view frame, WireFormat format) {
+        SensorMetadata metadata = format == WireFormat::BINARY ? ParseBinaryMetadata(frame)
+                                                               : ParseMetadata(frame, true);
+        if (!CheckMetadata(&metadata)) {
+            return;
+        }
+        for (BaseSensor *sensor : memory) {
+            if (sensor->UID == metadata.UID) {
+                sensor->parseValues(metadata.Data, metadata.Format, [&](size_t field, const NumericValue &number) {
+                    SensorUpdate update{sensor, UpdateKind::VALUE, static_cast<uint8_t>(field), number, 0};
+                    while (!queue.push(update)) {
+                        std::this_thread::yield();
+                    }
+                });
+                return;
+            }
+        }
+    });
+}
+
+#endif // HEADLESS_SENSOR_HPP
@@ -31,12 +31,86 @@ def generate_messages():
     ]
     return messages
 
+# Push periods of subscribed sensors [s], set by ?SUBSCRIBE&id=X&period=P (P in ms, 0 on change)
+periods = {}
+
+# Delta frames: replies to ?UPDATE of all or listed sensors are numbered by seq, fields sent by them
+# are kept per sensor, ?UPDATE&ack=N acknowledging the last numbered reply gets only the fields changed since
+seq = 0
+sent = {}
+
+def split_message(msg):
+    uid, *fields = msg[1:].split("&")
+    return uid[3:], [field.split("=", 1) for field in fields]
+
+def numbered(messages, ack):
+    global seq
+    delta = ack is not None and ack == str(seq)
+    seq += 1
+    frames = []
+    for msg in messages:
+        uid, fields = split_message(msg)
+        last = sent.setdefault(uid, {})
+        changed = [(key, value) for key, value in fields if not delta or last.get(key) != value]
+        last.update(fields)
+        if changed:
+            frames.append(f"?id={uid}&seq={seq}" + "".join(f"&{key}={value}" for key, value in changed))
+    # Nothing changed, only the number
+    return frames or [f"?seq={seq}"]
+
+def unnumbered(messages):
+    # The twin applied values the next delta does not compare to, such sensors are sent in full
+    for msg in messages:
+        sent.pop(split_message(msg)[0], None)
+    return messages
+
+def handle_request(request):
+    fields = dict(field.split("=", 1) for field in request[1:].split("&") if "=" in field)
+    if request.startswith("?SUBSCRIBE"):
+        if "id" in fields:
+            periods[fields["id"]] = int(fields.get("period", "0")) / 1000
+    elif request.startswith("?UNSUBSCRIBE"):
+        periods.clear()
+    elif request.startswith("?UPDATE"):
+        # Sensors listed by ?UPDATE&id=8,9 (all without id) answer in one line
+        if "id" not in fields:
+            return numbered(generate_messages(), fields.get("ack"))
+        ids = fields["id"].split(",")
+        listed = [msg for msg in generate_messages() if msg[4:].split("&", 1)[0] in ids]
+        if "req" not in fields:
+            return numbered(listed, fields.get("ack"))
+        # Numbered request (?UPDATE&id=X&req=N) is answered with its number, matching the reply to it
+        return [msg.replace("&", f"&req={fields['req']}&", 1) for msg in unnumbered(listed)]
+    return []
+
 try:
+    last_batch = 0
+    last_push = {}
     while True:
-        msg = " ".join(generate_messages())
-        ser.write(msg.encode("utf-8"))
-        print(f"Message sended to bus: {msg}")
-        time.sleep(2)
+        # Waits up to the port timeout, which is also the push tick
+        request = ser.readline().decode("utf-8", "ignore").strip()
+        due = handle_request(request) if request else []
+
+        now = time.monotonic()
+        if due:
+            print(f"Answering {request}")
+        elif periods:
+            # Subscribed: push every sensor at its own period (values change all the time,
+            # so "on change" sensors are pushed every tick)
+            due = unnumbered([msg for msg in generate_messages()
+                              if (uid := msg[4:].split("&", 1)[0]) in periods and now - last_push.get(uid, 0) >= periods[uid]])
+            for msg in due:
+                last_push[msg[4:].split("&", 1)[0]] = now
+        elif now - last_batch >= 2:
+            due = unnumbered(generate_messages())
+            last_batch = now
+        else:
+            continue
+
+        if due:
+            msg = " ".join(due)
+            ser.write((msg + "\n").encode("utf-8"))
+            print(f"Message sended to bus: {msg}")
 
 except KeyboardInterrupt:
     print("Comm closing...")
@@ -0,0 +1,151 @@
+/**
+ * @file fuzz_parser.cpp
+ * @brief Coverage-guided fuzzing entry point of the frame parsers.
+ *
+ * Every input is handled three ways, as a sensor list response (ParseSensorDeclaration(),
+ * the parser of createSensorList(memory, string)), as a batch of text and binary update
+ * frames (ParseMetadata() and the update of headless sensors of the emulator UIDs) and as a
+ * configuration string. Parsed views must stay inside the input, anything else aborts.
+ *
+ * Build with libFuzzer (from the repository root):
+ *   clang++ -std=c++17 -g -O1 -fsanitize=fuzzer,address,undefined -DSTDIO_H \
+ *       -DLV_CONF_INCLUDE_SIMPLE -Ilibraries -Ilibraries/lvgl -Ilibraries/engine -Ibenchmarks \
+ *       fuzz/fuzz_parser.cpp libraries/engine/base_sensor.cpp libraries/engine/coalescer.cpp \
+ *       libraries/engine/exceptions.cpp libraries/engine/frame_check.cpp libraries/engine/helpers.cpp \
+ *       libraries/engine/logs.cpp libraries/engine/messenger.cpp libraries/engine/parser.cpp \
+ *       libraries/engine/transport.cpp -o fuzz_parser
+ *   ./fuzz_parser -close_fd_mask=1 corpus/
+ *
+ * Without libFuzzer add -DFUZZ_STANDALONE (any compiler), the binary then runs the entry
+ * point once for every file given on the command line, or for stdin:
+ *   printf '?id=4&acm_x=1e999&&=?0:TOF&:' | ./fuzz_parser
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#include "headless_sensor.hpp"
+#include "frame_check.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Abort if the view does not point into the input.
+ */
+static void checkInside(std::string_view view, std::string_view input) {
+    if(view.empty()) {
+        return;
+    }
+    if(view.data() < input.data() || view.data() + view.size() > input.data() + input.size()) {
+        fprintf(stderr, "Parsed view outside of the input!\n");
+        abort();
+    }
+}
+
+/**
+ * @brief Sensors shared by all runs, as the manager keeps them between resyncs.
+ */
+struct SensorList
+{
+    std::vector<BaseSensor*> Memory;
+
+    SensorList() { createHeadlessSensorList(Memory); }
+    ~SensorList() { for (BaseSensor *sensor : Memory) delete sensor; }
+};
+
+static std::vector<BaseSensor*> &sensors() {
+    static SensorList list;
+    return list.Memory;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    std::string_view input(reinterpret_cast<const char*>(data), size);
+
+    // Sensor list response, as parsed by createSensorList(memory, string).
+    std::string_view cursor(input);
+    SensorDeclaration declaration;
+    while(ParseSensorDeclaration(cursor, declaration)) {
+        checkInside(declaration.UID, input);
+        checkInside(declaration.Type, input);
+    }
+
+    // Update frames, as dispatched by SensorManager::resync(), on a text and on a binary link.
+    for(WireFormat link : {WireFormat::TEXT, WireFormat::BINARY}) {
+        forEachWireFrame(input, link, [&input, link](std::string_view frame, WireFormat format) {
+            checkInside(frame, input);
+            if(link == WireFormat::TEXT && format == WireFormat::BINARY) {
+                fprintf(stderr, "Binary frame split on a text link!\n");
+                abort();
+            }
+            for(bool caseSensitive : {true, false}) {
+                SensorMetadata metadata = format == WireFormat::BINARY ? ParseBinaryMetadata(frame)
+                                                                       : ParseMetadata(frame, caseSensitive);
+                checkInside(metadata.UID, input);
+                checkInside(metadata.Status, input);
+                checkInside(metadata.Data, input);
+            }
+        });
+    }
+    ParseWireFormat(input);
+    ParseFrameCheck(input);
+
+    // Checked frames, their frames must stay inside the input too.
+    static FrameChecker checker;
+    checker.forEach(input, size % 2 == 0 ? WireFormat::TEXT : WireFormat::BINARY, [&input](std::string_view frame, WireFormat) {
+        checkInside(frame, input);
+    });
+    std::vector<BaseSensor*> &memory = sensors();
+    for(BaseSensor *sensor : memory) {
+        sensor->setCaseSensitive(size % 2 == 0);
+    }
+    WireFormat link = size % 3 == 0 ? WireFormat::BINARY : WireFormat::TEXT;
+    ingestFrames(memory, input, link, size % 2 == 0);
+
+    // The same frames through the coalescing stage, newest values first.
+    static UpdateCoalescer coalescer;
+    coalescer.setEnabled(true); // Independent of COALESCE_SYNC.
+    ingestFrames(memory, input, link, size % 2 == 0, &coalescer);
+    coalescer.flush();
+
+    // Configuration string, exceptions are caught by configSensor().
+    configSensor(memory[size % memory.size()], input);
+
+    // Values must stay printable, whatever was stored.
+    printSensor(memory[size % memory.size()]);
+
+    return 0;
+}
+
+#ifdef FUZZ_STANDALONE
+/**
+ * @brief Run the entry point for every file given on the command line, or for stdin.
+ */
+int main(int argc, char **argv) {
+    auto runInput = [](std::istream &stream) {
+        std::string input((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+        LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+    };
+
+    if(argc < 2) {
+        runInput(std::cin);
+    }
+    for(int i = 1; i < argc; ++i) {
+        std::ifstream file(argv[i], std::ios::binary);
+        if(!file) {
+            fprintf(stderr, "Cannot open %s\n", argv[i]);
+            return 1;
+        }
+        runInput(file);
+    }
+    printf("Processed %d input(s).\n", argc < 2 ? 1 : argc - 1);
+    return 0;
+}
+#endif // FUZZ_STANDALONE
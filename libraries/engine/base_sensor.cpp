@@ -22,7 +22,7 @@
 
     /*General functions*/
 
-    void configSensor(BaseSensor *sensor, const std::string &config) {
+    void configSensor(BaseSensor *sensor, std::string_view config) {
         if(sensor == nullptr) {
             return;
         }
@@ -36,13 +36,13 @@
     }
 
 
-    void updateSensor(BaseSensor *sensor, const std::string &update) {
+    void updateSensor(BaseSensor *sensor, std::string_view update, WireFormat format) {
         if(sensor == nullptr) {
             return;
         }
 
         try {
-            sensor->update(update);
+            sensor->update(update, format);
         } catch (const Exception &ex) {
             ex.print();
             sensor->setError(new Exception(ex));
@@ -101,4 +101,17 @@
         }
     }
 
+    void destructSensor(BaseSensor *sensor, bool deferred) {
+        if(sensor == nullptr) {
+            return;
+        }
+
+        try {
+            sensor->destruct(deferred);
+        } catch (const Exception &ex) {
+            ex.print();
+            sensor->setError(new Exception(ex));
+        }
+    }
+
 
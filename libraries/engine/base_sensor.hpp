@@ -22,10 +22,16 @@
 #include "helpers.hpp"     ///< Helper functions.
 #include "parser.hpp"      ///< Parser functions.
 #include "messenger.hpp"   ///< Messenger functions.
+#include "field_schema.hpp" ///< Field schemas.
+#include "sensor_health.hpp" ///< SensorHealth.
+#include "sensor_update.hpp" ///< SensorUpdate.
 
 #include <string>
-#include <unordered_map>
-#include <map>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
 extern "C"
 {
 #include "lvgl.h"
@@ -66,35 +72,328 @@ enum class SensorsCommands
      RESET
  };
 
-/**
- * @enum DataType
- * @brief Enumeration representing possible parametrs data types.
- *
- * - INT: int.
- * - DOUBLE: double.
-*  - FLOAT: float.
- * - STRING: string.
- */
-enum class DataType {
-    INT,
-    DOUBLE,
-    FLOAT,
-    STRING
-};
-
 /**
  * @struct SensorParam
  * @brief Structure for sensor parameters.
  * 
  * This structure can be used to store sensor parameters for configuration and updating.
+ * Numeric parameters are parsed once when set and kept in their native type, the display
+ * text is formatted only when it is requested and cached until the value changes.
  */
 struct SensorParam
 {
-    std::string Value;  ///< Parameter value.
-    std::string Unit;   ///< Parameter unit.
-    DataType DType; ///< Parameter data type.
-    int lastHistoryIndex; ///< Last history index.
-    std::string History[HISTORY_CAP]; ///< Parameter history.
+    DataType DType = DataType::STRING;  ///< Parameter data type.
+    NumericValue Number = {0};          ///< Numeric value of INT, FLOAT and DOUBLE parameter.
+    mutable std::string Text;           ///< Value of STRING parameter, cached display text of numeric one.
+    mutable bool TextPending = false;   ///< Flag if Text has to be formatted from Number.
+    int lastHistoryIndex = 0;           ///< Position of the oldest history entry.
+    NumericValue History[HISTORY_CAP] = {}; ///< Parameter history.
+    unsigned long UpdatedMs = 0;        ///< Time of the last received value (see getTimeMs).
+    bool Received = false;              ///< Flag if any value was received.
+
+    /**
+     * @brief Set the data type and default value, fill history with it.
+     * 
+     * @param type The parameter data type.
+     * @param value The default value.
+     * @throws InvalidDataTypeException if the value does not match the type.
+     */
+    void reset(DataType type, const std::string &value)
+    {
+        DType = type;
+        set(value);
+        for (int i = 0; i < HISTORY_CAP; ++i) {
+            History[i] = Number;
+        }
+        lastHistoryIndex = 0;
+    }
+
+    /**
+     * @brief Parse and store new value, without throwing.
+     * 
+     * @param value The value as text.
+     * @return true if the value was stored, false if it does not match the type.
+     */
+    bool assign(std::string_view value)
+    {
+        if (DType == DataType::STRING) {
+            Text.assign(value.data(), value.size());
+            return true;
+        }
+        if (!parse(value, Number)) {
+            return false;
+        }
+        TextPending = true;
+        return true;
+    }
+
+    /**
+     * @brief Parse numeric value, nothing is stored.
+     * 
+     * Reads only the data type, so a value may be parsed by another thread than the one
+     * applying it (see apply). STRING values are not parsed, they need storage.
+     * 
+     * @param value The value as text.
+     * @param number The parsed value.
+     * @return true if parsed, false if it does not match the type or the parameter is STRING.
+     */
+    bool parse(std::string_view value, NumericValue &number) const
+    {
+        switch (DType) {
+        case DataType::INT:
+            return parseNumber(value, number.Int) == ParseStatus::OK;
+        case DataType::FLOAT:
+            return parseNumber(value, number.Float) == ParseStatus::OK;
+        case DataType::DOUBLE:
+            return parseNumber(value, number.Double) == ParseStatus::OK;
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * @brief Store new value received in binary frame, without throwing.
+     * 
+     * @param word The value as 32-bit word, int32 for INT and float32 for FLOAT and DOUBLE parameter.
+     * @return true if the value was stored, false if it is not finite or the parameter is STRING.
+     */
+    bool assign(uint32_t word)
+    {
+        if (!parse(word, Number)) {
+            return false;
+        }
+        TextPending = true;
+        return true;
+    }
+
+    /**
+     * @brief Decode value received in binary frame, nothing is stored.
+     * 
+     * @param word The value as 32-bit word, int32 for INT and float32 for FLOAT and DOUBLE parameter.
+     * @param number The decoded value.
+     * @return true if decoded, false if it is not finite or the parameter is STRING.
+     */
+    bool parse(uint32_t word, NumericValue &number) const
+    {
+        float real;
+        switch (DType) {
+        case DataType::INT:
+            number.Int = static_cast<int32_t>(word);
+            return true;
+        case DataType::FLOAT:
+        case DataType::DOUBLE:
+            std::memcpy(&real, &word, sizeof(real));
+            if (!std::isfinite(real)) {
+                return false;
+            }
+            if (DType == DataType::FLOAT) {
+                number.Float = real;
+            }
+            else {
+                number.Double = real;
+            }
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * @brief Store value parsed by parse() and append it to the history.
+     * 
+     * @param number The parsed value.
+     * @param now The receive time (see getTimeMs).
+     */
+    void apply(const NumericValue &number, unsigned long now)
+    {
+        Number = number;
+        TextPending = true;
+        record(now);
+    }
+
+    /**
+     * @brief Parse and store new value.
+     * 
+     * @param value The value as text.
+     * @throws InvalidDataTypeException if the value does not match the type.
+     */
+    void set(const std::string &value)
+    {
+        if (!assign(value)) {
+            throw InvalidDataTypeException("SensorParam::set", value + " is not valid value of the parameter type!");
+        }
+    }
+
+    /**
+     * @brief Append current value to the history and mark it as received.
+     * 
+     * @param now The receive time (see getTimeMs).
+     */
+    void record(unsigned long now)
+    {
+        UpdatedMs = now;
+        Received = true;
+        History[lastHistoryIndex++] = Number;
+        if (lastHistoryIndex >= HISTORY_CAP) {
+            lastHistoryIndex = 0;
+        }
+    }
+
+    /**
+     * @brief Get value as display text, formatted on first use after change.
+     */
+    const std::string &text() const
+    {
+        if (TextPending) {
+            char buffer[32];
+            switch (DType) {
+            case DataType::INT:
+                formatNumber(buffer, sizeof(buffer), Number.Int);
+                break;
+            case DataType::FLOAT:
+                formatNumber(buffer, sizeof(buffer), Number.Float);
+                break;
+            case DataType::DOUBLE:
+                formatNumber(buffer, sizeof(buffer), Number.Double);
+                break;
+            default:
+                buffer[0] = '\0';
+                break;
+            }
+            Text = buffer;
+            TextPending = false;
+        }
+        return Text;
+    }
+
+    /**
+     * @brief Append value as text to the outbound frame, nothing is cached or allocated.
+     */
+    FrameBuilder &appendTo(FrameBuilder &frame) const
+    {
+        switch (DType) {
+        case DataType::INT:
+            return frame.append(Number.Int);
+        case DataType::FLOAT:
+            return frame.append(static_cast<double>(Number.Float));
+        case DataType::DOUBLE:
+            return frame.append(Number.Double);
+        default:
+            return frame;
+        }
+    }
+
+    /**
+     * @brief Get numeric value converted to the requested type.
+     * 
+     * @param number The numeric value, current value or history entry.
+     * @throws InvalidDataTypeException if STRING parameter is not convertible.
+     */
+    template <typename T>
+    T as(const NumericValue &number) const
+    {
+        if constexpr (std::is_same<T, std::string>::value) {
+            return text();
+        }
+        else {
+            switch (DType) {
+            case DataType::INT:
+                return static_cast<T>(number.Int);
+            case DataType::FLOAT:
+                return static_cast<T>(number.Float);
+            case DataType::DOUBLE:
+                return static_cast<T>(number.Double);
+            default:
+                return convertStringToType<T>(Text);
+            }
+        }
+    }
+
+    /**
+     * @brief Get current value converted to the requested type.
+     */
+    template <typename T>
+    T as() const { return as<T>(Number); }
+};
+
+/**
+ * @class FieldSet
+ * @brief View of the sensor parameters described by a field schema.
+ * 
+ * The parameters themselves are stored by the sensor in a fixed-size array, the set
+ * only binds them to their schema and to the compile-time generated lookup.
+ */
+class FieldSet
+{
+public:
+    typedef int (*Finder)(std::string_view key, bool caseSensitive); ///< Lookup of field position by name.
+
+    FieldSet() : Schema(nullptr), Params(nullptr), Count(0), Lookup(nullptr) {}
+
+    /**
+     * @brief Bind the set to the sensor parameters.
+     * 
+     * @param schema The field schema.
+     * @param params The parameters storage, one per schema field.
+     * @param count The number of fields.
+     * @param lookup The lookup of field position by name.
+     */
+    void bind(const FieldSchema *schema, SensorParam *params, size_t count, Finder lookup)
+    {
+        Schema = schema;
+        Params = params;
+        Count = count;
+        Lookup = lookup;
+    }
+
+    /**
+     * @brief Get number of fields.
+     */
+    size_t size() const { return Count; }
+
+    /**
+     * @brief Get schema of the field at given position.
+     */
+    const FieldSchema &schema(size_t i) const { return Schema[i]; }
+
+    /**
+     * @brief Get parameter of the field at given position.
+     */
+    SensorParam &operator[](size_t i) { return Params[i]; }
+    const SensorParam &operator[](size_t i) const { return Params[i]; }
+
+    /**
+     * @brief Find position of the field with given name.
+     * 
+     * @param key The field name.
+     * @param caseSensitive Flag if the name is matched case-sensitive.
+     * @return The field position, or -1 if not present.
+     */
+    int indexOf(std::string_view key, bool caseSensitive = true) const { return Lookup ? Lookup(key, caseSensitive) : -1; }
+
+    /**
+     * @brief Find parameter of the field with given name.
+     * 
+     * @param key The field name.
+     * @param caseSensitive Flag if the name is matched case-sensitive.
+     * @return Pointer to the parameter, or nullptr if not present.
+     */
+    SensorParam *find(std::string_view key, bool caseSensitive = true)
+    {
+        int i = indexOf(key, caseSensitive);
+        return i < 0 ? nullptr : &Params[i];
+    }
+    const SensorParam *find(std::string_view key, bool caseSensitive = true) const
+    {
+        int i = indexOf(key, caseSensitive);
+        return i < 0 ? nullptr : &Params[i];
+    }
+
+private:
+    const FieldSchema *Schema; ///< Field schema.
+    SensorParam *Params;       ///< Parameters storage.
+    size_t Count;              ///< Number of fields.
+    Finder Lookup;             ///< Lookup of field position by name.
 };
 
 /**
@@ -110,9 +409,10 @@ protected:
     bool redrawPenging = true;    ///< Flag to indicate if sensor needs to be redrawn.
     bool isConfigsSync = false;          ///< Flag to indicate if sensor congig is synchronized with real sensor.
     bool isValuesSync = false;          ///< Flag to indicate if sensor values is synchronized with real sensor.
+    bool CaseSensitiveKeys = CASE_SENSITIVE_SYNC; ///< Flag if keys of received frames are matched case-sensitive.
 
-    std::unordered_map<std::string, SensorParam> Values; ///< Sensor values.
-    std::map<std::string, SensorParam> Configs;          ///< Sensor configurations.
+    FieldSet Values;  ///< Sensor values.
+    FieldSet Configs; ///< Sensor configurations.
 
     /**
      * @brief Set sensor status.
@@ -121,68 +421,118 @@ protected:
      * 
      * @param status The status string.
      */
-    void setStatus(std::string status)
+    void setStatus(std::string_view status)
     {
-        if( status.empty() )
-        {
-            return;
-        }
-
-        if(status == "1")
-        {
-            Status = SensorStatus::OK;
-        }
-        else if(status == "-1")
-        {
-            Status = SensorStatus::ERROR;
-        }
-        else if(status == "0")
-        {
-            Status = SensorStatus::OFFLINE;
-        }
+        parseStatus(status, Status);
     }
 
+    /**
+     * @brief Get messenger of the bus the sensor is on.
+     */
+    Messenger &getLink() const { return Link ? *Link : getMessenger(); }
+
     /**
      * @brief Synchronize sensor configurations with real sensor.
      * 
      * This function sends a request to the real sensor to synchronize the configurations.
      */
     void syncConfigs() {
-        std::string configRequest = "?CONFIG&id=" + UID;
-        for (auto &c : Configs) {
-            configRequest += "&" + c.first + "=" + c.second.Value;
+        Messenger &link = getLink();
+        FrameBuilder &request = link.compose().command("CONFIG").field("id", UID);
+        for (size_t i = 0; i < Configs.size(); ++i) {
+            request.append('&').append(Configs.schema(i).Name).append('=');
+            Configs[i].appendTo(request);
         }
-        sendMessage(configRequest);
+        link.send();
 
         isConfigsSync = true; // Set flag to indicate sensor is synchronized with real sensor.
     }
 
     /**
-     * @brief Synchronize sensor values with real sensor.
+     * @brief Apply binary fields, the field id is the value position in the schema.
      * 
-     * This function sends a request to the real sensor to synchronize the values.
+     * @param fields The fields of BINARY_FIELD_SIZE bytes each.
+     * @param applied Mask of value positions to skip, applied ones are added (nullptr for a fresh mask).
+     * @return The number of applied values.
      */
-    void syncValues()
+    size_t updateBinary(std::string_view fields, uint32_t *applied = nullptr)
     {
-        isValuesSync = false; // Set flag to indicate sensor is not synchronized with real sensor.
-        std::string updateRequest = "?UPDATE&id=" + UID;
-        std::string updateResponse = "";
+        uint32_t local = 0;
+        if (!applied) applied = &local; // A field repeated in the frame: the first occurrence wins.
+        unsigned long now = getTimeMs();
+        size_t count = 0;
+        for (; fields.size() >= BINARY_FIELD_SIZE; fields.remove_prefix(BINARY_FIELD_SIZE)) {
+            size_t id = static_cast<uint8_t>(fields[0]);
+            if (isApplied(applied, id)) {
+                continue; // Superseded by a newer value.
+            }
+            if (id >= Values.size() || !Values[id].assign(readUint32LE(fields.data() + 1))) {
+                ++RejectedValues; // Unknown field or malformed value, keep the last valid one.
+                continue;
+            }
+            Values[id].record(now);
+            markApplied(applied, id);
+            ++count;
 
-        //Check if response is valid
-        SensorMetadata metadata;
-        //Start update sync process
-        sendMessage(updateRequest);
-        updateResponse = receiveMessage();
-        metadata = ParseMetadata(updateResponse);
+            redrawPenging = true; // Set flag to redraw sensor - values updated.
+        }
+        if (!fields.empty()) {
+            ++RejectedValues; // Truncated field.
+        }
+        return count;
+    }
 
-        if( IsValid(&metadata, UID) )
-        {
-            update(metadata.Data);
-            setStatus(metadata.Status);
+    /**
+     * @brief Apply key-value text fields through the schema lookup.
+     * 
+     * @param fields The fields (e.g. "id=4&Temperature=27&acm_x=-3").
+     * @param applied Mask of value positions to skip, applied ones are added (nullptr for a fresh mask).
+     * @return The number of applied values.
+     */
+    size_t updateText(std::string_view fields, uint32_t *applied = nullptr)
+    {
+        // Fields missing in the frame (delta frames) keep their value and receive time.
+        uint32_t local = 0;
+        if (!applied) applied = &local; // A key repeated in the frame: the first occurrence wins.
+        unsigned long now = getTimeMs();
+        size_t count = 0;
+        std::string_view cursor(fields);
+        KeyValueToken token;
+        while (nextKeyValueToken(cursor, token, '&')) {
+            int id = Values.indexOf(token.Key, CaseSensitiveKeys);
+            if (id < 0 || token.Value.empty() || isApplied(applied, id)) {
+                continue;
+            }
+
+            if (!Values[id].assign(token.Value)) {
+                ++RejectedValues; // Malformed value, keep the last valid one.
+                continue;
+            }
+            Values[id].record(now);
+            markApplied(applied, id);
+            ++count;
 
             redrawPenging = true; // Set flag to redraw sensor - values updated.
-            isValuesSync = true; // Set flag to indicate sensor is synchronized with real sensor.  
-        }      
+        }
+        return count;
+    }
+
+    /**
+     * @brief Check if the value position is in the mask (schemas have at most 32 values).
+     */
+    static bool isApplied(const uint32_t *applied, size_t id)
+    {
+        return applied && id < 32 && (*applied & (1u << id));
+    }
+
+    /**
+     * @brief Add the value position to the mask.
+     */
+    static void markApplied(uint32_t *applied, size_t id)
+    {
+        if (applied && id < 32) {
+            *applied |= 1u << id;
+        }
     }
 
 public:
@@ -191,6 +541,13 @@ public:
     std::string Type;       ///< Sensor type as text.
     std::string Description;///< Description of the sensor.
     Exception *Error;       ///< Pointer to an exception object (if any).
+    unsigned long RejectedValues = 0; ///< Number of received values rejected as malformed.
+    unsigned long SubscribePeriodMs = SUBSCRIBE_PERIOD_MS; ///< Push period in subscribe mode [ms], 0 on change only.
+    unsigned long SamplePeriodMs = SAMPLE_PERIOD_MS; ///< Request period when polled by resync() [ms].
+    bool HistoryAllSamples = COALESCE_HISTORY; ///< Flag if coalesced samples still feed the history.
+    Messenger *Link = nullptr;      ///< Messenger of the bus the sensor is on, nullptr for the global messenger.
+    unsigned long TimeoutMs = SENSOR_TIMEOUT; ///< Reply deadline of the sensor requests [ms].
+    SensorHealth Health;            ///< Replies, backoff and offline detection.
 
     //lv_obj_t *ui_Container; ///< Pointer to the UI widgets container.
     /**
@@ -245,17 +602,14 @@ public:
      */
     template <typename T>
     T getConfig(const std::string &key) {
-        std::string value;
-        if (Configs.find(key) != Configs.end()) {
-            value = Configs[key].Value;
-        }
-        if(value.empty()) {
+        SensorParam *param = Configs.find(key);
+        if(!param) {
             throw ConfigurationNotFoundException("BaseSensor::getConfig", "Configuration not found for key: " + key);
         }
         
         try
         {
-            return convertStringToType<T>(value);
+            return param->as<T>();
         }
         catch(const std::exception& e)
         {
@@ -272,8 +626,8 @@ public:
      * @param value The value to set.
      */
     void setConfig(const std::string &key, const std::string &value) {
-        if (Configs.find(key) != Configs.end()) {
-            Configs[key].Value = value;
+        if (SensorParam *param = Configs.find(key)) {
+            param->set(value);
         }
         else{
             throw ConfigurationNotFoundException("BaseSensor::setConfig", "Configuration not found for key: " + key);
@@ -292,17 +646,14 @@ public:
      */
     template <typename T>
     T getValue(const std::string &key) {
-        std::string value;
-        if (Values.find(key) != Values.end()) {
-            value = Values[key].Value;
-        }
-        if(value.empty()) {
+        SensorParam *param = Values.find(key);
+        if(!param) {
             throw ValueNotFoundException("BaseSensor::getValue", "Value not found for key: " + key);
         }
         
         try
         {
-            return convertStringToType<T>(value);
+            return param->as<T>();
         }
         catch(const std::exception& e)
         {
@@ -321,56 +672,37 @@ public:
     template <typename T>
     void getHistory(const std::string &key, lv_coord_t *history) {
         if (!history) return;
-        auto it = Values.find(key);
-        if (it == Values.end()) return;
-    
-        // statické úložiště mezi voláními
-        static std::map<std::string, std::array<lv_coord_t, HISTORY_CAP>> bufMap;
-        static std::map<std::string, bool> initedMap;
-    
-        auto &buf    = bufMap[key];
-        bool &inited = initedMap[key];
-    
-        // 1) Místo čtení z History[], načti aktuální hodnotu jako string a převeď
-        lv_coord_t curr;
+        const SensorParam *param = Values.find(key);
+        if (!param) return;
+
+        // Copy history from the oldest to the newest entry.
         try {
-            // getValue vrací string, kterej jste dřív ukládali např. "100"
-            std::string s = getValue<std::string>(key);
-            curr = convertStringToType<T>(s);
-        }
-        catch (const std::exception &e) {
-            throw InvalidDataTypeException("BaseSensor::getValue", e.what());
-        }
-    
-        if (!inited) {
-            // první volání: celý buffer naplň aktuální hodnotou
             for (int i = 0; i < HISTORY_CAP; ++i) {
-                buf[i] = curr;
+                const NumericValue &entry = param->History[(param->lastHistoryIndex + i) % HISTORY_CAP];
+                history[i] = static_cast<lv_coord_t>(param->as<T>(entry));
             }
-            inited = true;
         }
-        else {
-            // posuň doleva o jednu pozici …
-            for (int i = 0; i < HISTORY_CAP - 1; ++i) {
-                buf[i] = buf[i + 1];
-            }
-            // … a na konec vlož okamžitý curr
-            buf[HISTORY_CAP - 1] = curr;
-        }
-    
-        // 2) Zkopíruj celý buffer do výstupního pole
-        for (int i = 0; i < HISTORY_CAP; ++i) {
-            try {
-                history[i] = buf[i];
-            }
-            catch (const std::exception &e) {
-                throw InvalidDataTypeException("BaseSensor::getValue", e.what());
-            }
+        catch (const std::exception &e) {
+            throw InvalidDataTypeException("BaseSensor::getHistory", e.what());
         }
     }
-    
-    
 
+    /**
+     * @brief Get age of sensor value.
+     * 
+     * Delta frames carry only changed fields, the age tells how long ago the
+     * value was last received.
+     * 
+     * @param key The key of the sensor parameter.
+     * @return Milliseconds since the value was received, ULONG_MAX if it never was.
+     */
+    unsigned long getValueAge(const std::string &key) const {
+        const SensorParam *param = Values.find(key);
+        if (!param) {
+            throw ValueNotFoundException("BaseSensor::getValueAge", "Value not found for key: " + key);
+        }
+        return param->Received ? getTimeMs() - param->UpdatedMs : ULONG_MAX;
+    }
 
     /**
      * @brief Set sensor value.
@@ -381,8 +713,8 @@ public:
      * @param value The value to set.
      */
     void setValue(const std::string &key, const std::string &value) {
-        if (Values.find(key) != Values.end()) {
-            Values[key].Value = value;
+        if (SensorParam *param = Values.find(key)) {
+            param->set(value);
         }
         else{
             throw ValueNotFoundException("BaseSensor::setValue", "Value not found for key: " + key);
@@ -398,8 +730,9 @@ public:
      * @return The units of the value sensor parameter.
      */
     std::string getValueUnits(const std::string &key) {
-        if (Values.find(key) != Values.end()) {
-            return Values[key].Unit;
+        int i = Values.indexOf(key);
+        if (i >= 0) {
+            return Values.schema(i).Unit;
         }
         return "";
     }
@@ -413,12 +746,32 @@ public:
      * @return The units of the sensor config parameter.
      */
     std::string getConfigUnits(const std::string &key) {
-        if (Configs.find(key) != Configs.end()) {
-            return Configs[key].Unit;
+        int i = Configs.indexOf(key);
+        if (i >= 0) {
+            return Configs.schema(i).Unit;
         }
         return "";
     }
 
+    /**
+     * @brief Select case-sensitive or case-insensitive matching of received keys.
+     * 
+     * Case-insensitive matching folds the keys while hashing and comparing,
+     * the received frames are never copied nor rewritten.
+     * 
+     * @param caseSensitive Flag if keys are matched case-sensitive.
+     */
+    void setCaseSensitive(bool caseSensitive) {
+        CaseSensitiveKeys = caseSensitive;
+    }
+
+    /**
+     * @brief Check if received keys are matched case-sensitive.
+     */
+    bool isCaseSensitive() const {
+        return CaseSensitiveKeys;
+    }
+
     /**
      * @brief Set exception as error and change status accordingly.
      * 
@@ -452,117 +805,287 @@ public:
     }
 
     /**
-     * @brief Synchronize with the real sensor.
+     * @brief Start pipelined synchronization with the real sensor.
      * 
-     * @throws Exception if synchronization fails.
+     * Sends the configurations unless synchronized, the values are requested by the caller
+     * (see SensorManager::syncAll) and the reply is passed to receiveValues().
      */
-    virtual void synchronize()
+    void beginSync()
     {
         isValuesSync = false; // Set flag to indicate sensor is not synchronized with real sensor.
         if(!isConfigsSync)
         {
-            try
-            {
-                syncConfigs();
-            }
-            catch(const Exception& e)
-            {
-                throw;
-            }
+            syncConfigs();
         }
+    }
 
-        if(!isValuesSync)
+    /**
+     * @brief Apply reply to the values request.
+     * 
+     * @param metadata The parsed reply.
+     * @return true if the reply belongs to the sensor and the values are synchronized.
+     */
+    bool receiveValues(const SensorMetadata &metadata)
+    {
+        if( !IsValid(&metadata, UID) )
         {
-            try
-            {
-                syncValues();
-            }
-            catch(const Exception& e)
-            {
-                throw;
-            }
+            return false;
         }
+        markResponsive(getTimeMs());
+        update(metadata.Data, metadata.Format);
+        setStatus(metadata.Status);
+
+        redrawPenging = true; // Set flag to redraw sensor - values updated.
+        isValuesSync = true; // Set flag to indicate sensor is synchronized with real sensor.
+        return true;
     }
 
     /**
-     * @brief Add configuration parameter to the sensor.
+     * @brief Record a reply or update frame of the sensor, an offline sensor is OK again.
      * 
-     * @param key The key of the configuration parameter.
-     * @param param The configuration parameter to add.
+     * @param now The receive time (see getTimeMs).
      */
-    void addConfigParameter(const std::string &key, const SensorParam &param) {
-        try
+    void markResponsive(unsigned long now)
+    {
+        if( Health.replied(now) )
         {
-            Configs[key] = param;
+            setOnline();
         }
-        catch(const std::exception& e)
+    }
+
+    /**
+     * @brief Record a request of the sensor which timed out, the sensor backs off.
+     * 
+     * @param now The time of the timeout (see getTimeMs).
+     */
+    void markUnresponsive(unsigned long now)
+    {
+        if( Health.timedOut(now, TimeoutMs) )
         {
-            throw InvalidConfigurationException("BaseSensor::addConfigParameter", e.what());
+            setOffline();
         }
+    }
 
-        isConfigsSync = false; // Set flag to indicate sensor is not synchronized with real sensor.
+    /**
+     * @brief Make an offline sensor OK again, it replied.
+     */
+    void setOnline()
+    {
+        if( Status == SensorStatus::OFFLINE )
+        {
+            Status = SensorStatus::OK; // The status reported by the device, if any, follows.
+            redrawPenging = true;
+            logMessage("Sensor %s is back online.\n", UID.c_str());
+        }
     }
 
     /**
-     * @brief Configures the sensor with the given configuration string.
+     * @brief Make the sensor offline, it stopped replying.
+     */
+    void setOffline()
+    {
+        Status = SensorStatus::OFFLINE;
+        redrawPenging = true;
+        logMessage("Sensor %s is offline, probing it at a reduced rate.\n", UID.c_str());
+    }
+
+    /**
+     * @brief Parse the status reported by the device ("1", "-1" or "0").
      * 
-     * @param config The configuration string.
-     * @throws Exception if configuration fails.
+     * @param status The status text.
+     * @param parsed The parsed status, unchanged if the text is empty or unknown.
+     * @return true if parsed.
+     */
+    static bool parseStatus(std::string_view status, SensorStatus &parsed)
+    {
+        if(status == "1")
+        {
+            parsed = SensorStatus::OK;
+        }
+        else if(status == "-1")
+        {
+            parsed = SensorStatus::ERROR;
+        }
+        else if(status == "0")
+        {
+            parsed = SensorStatus::OFFLINE;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Check if a value is STRING, such values cannot pass the typed update queue.
      */
-    virtual void config(const std::string &cfg)
+    bool hasStringValues() const
     {
-        std::string value;
-        // Parse the config string and update the sensor configs.
-        for (auto &c : Configs) {
-            value = getValueFromKeyValueLikeString(cfg, c.first, '&');
-            if(!value.empty()) {
-                c.second.Value = value;
+        for (size_t i = 0; i < Values.size(); ++i) {
+            if (Values.schema(i).DType == DataType::STRING) {
+                return true;
             }
         }
+        return false;
     }
 
     /**
-     * @brief Adds a value parameter to the sensor.
+     * @brief Parse update fields into typed values, nothing is applied.
+     * 
+     * Reads only the values schema, so the communication task parses frames while the
+     * UI thread applies the values (see applyUpdate) and draws. STRING values have no
+     * typed form, they are counted as rejected (see hasStringValues). Of a field repeated
+     * in the update only the first occurrence is emitted, as updateText applies it.
      * 
-     * @param key The key of the value parameter.
-     * @param param The value parameter to add.
-     * @throws Exception if adding the value parameter fails.
+     * @param upd The update fields.
+     * @param format The format of the update, key-value text or binary fields.
+     * @param emit Called with the value position and the parsed value.
+     * @return The number of rejected values.
      */
-    void addValueParameter(const std::string &key, const SensorParam &param) {
-        try
-        {
-            Values[key] = param;
+    template <typename F>
+    size_t parseValues(std::string_view upd, WireFormat format, F &&emit) const
+    {
+        size_t rejected = 0;
+        uint32_t emitted = 0;
+        NumericValue number;
+        if (format == WireFormat::BINARY) {
+            for (; upd.size() >= BINARY_FIELD_SIZE; upd.remove_prefix(BINARY_FIELD_SIZE)) {
+                size_t id = static_cast<uint8_t>(upd[0]);
+                if (isApplied(&emitted, id)) {
+                    continue;
+                }
+                if (id < Values.size() && Values[id].parse(readUint32LE(upd.data() + 1), number)) {
+                    markApplied(&emitted, id);
+                    emit(id, number);
+                }
+                else {
+                    ++rejected; // Unknown field or malformed value.
+                }
+            }
+            return upd.empty() ? rejected : rejected + 1; // Truncated field.
         }
-        catch(const std::exception& e)
-        {
-            throw InvalidValueException("BaseSensor::addValueParameter", new Exception(e));
+        std::string_view cursor(upd);
+        KeyValueToken token;
+        while (nextKeyValueToken(cursor, token, '&')) {
+            int id = Values.indexOf(token.Key, CaseSensitiveKeys);
+            if (id < 0 || token.Value.empty() || isApplied(&emitted, id)) {
+                continue;
+            }
+            if (Values[id].parse(token.Value, number)) {
+                markApplied(&emitted, id);
+                emit(static_cast<size_t>(id), number);
+            }
+            else {
+                ++rejected;
+            }
         }
+        return rejected;
+    }
 
-        isValuesSync = false; // Set flag to indicate sensor is not synchronized with real sensor.
+    /**
+     * @brief Apply update parsed by the communication task, on the UI thread.
+     * 
+     * @param update The update of this sensor.
+     */
+    void applyUpdate(const SensorUpdate &update)
+    {
+        switch (update.Kind) {
+        case UpdateKind::VALUE:
+            if (update.Field < Values.size()) {
+                Values[update.Field].apply(update.Number, update.ReceivedMs);
+                redrawPenging = true;
+            }
+            break;
+        case UpdateKind::STATUS:
+            Status = static_cast<SensorStatus>(update.Number.Int);
+            redrawPenging = true;
+            break;
+        case UpdateKind::ONLINE:
+            setOnline();
+            break;
+        case UpdateKind::OFFLINE:
+            setOffline();
+            break;
+        case UpdateKind::REJECTED:
+            RejectedValues += static_cast<unsigned long>(update.Number.Int);
+            break;
+        }
+    }
+
+    /**
+     * @brief Check if configurations and values are synchronized with the real sensor.
+     */
+    bool isSynchronized() const { return isConfigsSync && isValuesSync; }
+
+    /**
+     * @brief Synchronize with the real sensor.
+     * 
+     * Sends the configurations unless synchronized. The values are requested by the bus
+     * of the sensor (see BusShard::sync), so their reply is split and checked in the format
+     * negotiated by ?INIT, and passed to receiveValues().
+     * 
+     * @throws Exception if synchronization fails.
+     */
+    virtual void synchronize()
+    {
+        beginSync();
+    }
+
+    /**
+     * @brief Configures the sensor with the given configuration string.
+     * 
+     * @param config The configuration string.
+     * @throws Exception if configuration fails.
+     */
+    virtual void config(std::string_view cfg)
+    {
+        // Walk the config string once and dispatch its fields through the schema lookup.
+        std::string_view cursor(cfg);
+        KeyValueToken token;
+        while (nextKeyValueToken(cursor, token, '&')) {
+            SensorParam *param = Configs.find(token.Key, CaseSensitiveKeys);
+            if (param && !token.Value.empty()) {
+                param->set(std::string(token.Value));
+            }
+        }
     }
 
     /**
      * @brief Updates the sensor with new data.
      * 
      * @param update The update string containing new sensor data.
+     * @param format The format of the update, key-value text or binary fields.
      * @throws Exception if update fails.
      */
-    virtual void update(const std::string &upd)
-    {
-        std::string value;
-        // Parse the update string and update the sensor values.
-        for (auto &c : Values) {
-            value = getValueFromKeyValueLikeString(upd, c.first, '&');
-            if(!value.empty()) {
-                c.second.Value = value;
-                c.second.History[c.second.lastHistoryIndex++] = value;
-                if( c.second.lastHistoryIndex >= HISTORY_CAP ) {
-                    c.second.lastHistoryIndex = 0;
-                }
+    virtual void update(std::string_view upd, WireFormat format = WireFormat::TEXT)
+    {
+        if (format == WireFormat::BINARY) {
+            updateBinary(upd);
+            return;
+        }
 
-                redrawPenging = true; // Set flag to redraw sensor - values updated.
-            }
+        // Walk the update string once and dispatch its fields through the schema lookup.
+        updateText(upd);
+    }
+
+    /**
+     * @brief Apply only values not applied from a newer frame yet (latest value wins).
+     * 
+     * Frames of one coalescing round are applied from the newest, each value position
+     * is applied once and the older frames only fill positions the newer ones lack.
+     * 
+     * @param upd The update fields.
+     * @param format The format of the update, key-value text or binary fields.
+     * @param applied Mask of value positions applied in this round, updated.
+     * @return The number of applied values, 0 if the frame is entirely superseded.
+     */
+    size_t coalesce(std::string_view upd, WireFormat format, uint32_t &applied)
+    {
+        if (Values.size() < 32 && applied == (1u << Values.size()) - 1) {
+            return 0; // All values applied, the frame is not even parsed.
         }
+        return format == WireFormat::BINARY ? updateBinary(upd, &applied) : updateText(upd, &applied);
     }
 
     /**
@@ -578,12 +1101,12 @@ public:
             logMessage("\tSensor Status: %d\n", Status);
             logMessage("\tSensor Error: %s\n", getError().c_str());
             logMessage("\tSensor Configurations:\n");
-            for (auto &c : Configs) {
-                logMessage("\t\t%s: %s %s\n", c.first.c_str(), c.second.Value.c_str(), c.second.Unit.c_str());
+            for (size_t i = 0; i < Configs.size(); ++i) {
+                logMessage("\t\t%s: %s %s\n", Configs.schema(i).Name, Configs[i].text().c_str(), Configs.schema(i).Unit);
             }
             logMessage("\tSensor Values:\n");
-            for (auto &v : Values) {
-                logMessage("\t\t%s: %s %s\n", v.first.c_str(), v.second.Value.c_str(), v.second.Unit.c_str());
+            for (size_t i = 0; i < Values.size(); ++i) {
+                logMessage("\t\t%s: %s %s\n", Values.schema(i).Name, Values[i].text().c_str(), Values.schema(i).Unit);
             }
         }
         catch(const std::exception& e)
@@ -619,6 +1142,17 @@ public:
     /** @brief Hide this sensor’s UI widget (implemented by derived classes) */
     virtual void hide() = 0;    
 
+    /**
+     * @brief Delete this sensor’s UI widget, construct() builds it again (implemented by derived classes)
+     *
+     * @param deferred Flag if the widget is deleted by the next lv_timer_handler(), as needed from
+     *                 an event of its own navigation button; otherwise its memory is freed at once.
+     */
+    virtual void destruct(bool deferred) = 0;
+
+    /** @brief Draw the sensor on the next draw(), e.g. into a newly constructed widget */
+    void requestRedraw() { redrawPenging = true; }
+
     void addNavButtonsToWidget(lv_obj_t* parentWidget) {
         lv_obj_t* btnPrev = lv_btn_create(parentWidget);
         lv_obj_set_width(btnPrev, 80);
@@ -659,6 +1193,62 @@ public:
     }
 };
 
+/**
+ * @class SchemaSensor
+ * @brief Base class for sensors with compile-time field schema.
+ * 
+ * The schema type provides two constexpr arrays of FieldSchema, `Values` and `Configs`.
+ * The sensor parameters are stored in fixed-size arrays laid out by the schema and the
+ * incoming keys are dispatched by perfect-hash lookups generated from it, so updating
+ * the sensor needs no hashing of std::string, no node allocation and no pointer chasing.
+ * 
+ * @tparam Schema The sensor field schema.
+ */
+template <typename Schema>
+class SchemaSensor : public BaseSensor {
+protected:
+    static constexpr size_t VALUES_COUNT = Schema::Values.size();   ///< Number of values.
+    static constexpr size_t CONFIGS_COUNT = Schema::Configs.size(); ///< Number of configurations.
+
+    static constexpr FieldLookup<VALUES_COUNT> ValuesLookup{Schema::Values};    ///< Values lookup.
+    static constexpr FieldLookup<CONFIGS_COUNT> ConfigsLookup{Schema::Configs}; ///< Configurations lookup.
+
+    static_assert(ValuesLookup.isPerfect(), "No perfect hash found for sensor values schema");
+    static_assert(ConfigsLookup.isPerfect(), "No perfect hash found for sensor configs schema");
+    static_assert(VALUES_COUNT <= 32, "Coalescing marks applied values in a 32-bit mask");
+    static_assert(!THREADED_SYNC || !hasStringField(Schema::Values),
+                  "STRING values cannot pass the typed update queue of THREADED_SYNC");
+
+    std::array<SensorParam, VALUES_COUNT> ValuesStorage;   ///< Values storage.
+    std::array<SensorParam, CONFIGS_COUNT> ConfigsStorage; ///< Configurations storage.
+
+    static int findValue(std::string_view key, bool caseSensitive) { return ValuesLookup.find(key, caseSensitive); }
+    static int findConfig(std::string_view key, bool caseSensitive) { return ConfigsLookup.find(key, caseSensitive); }
+
+public:
+    /**
+     * @brief Constructs a new SchemaSensor object with default parameter values.
+     * 
+     * @param uid The unique sensor identifier.
+     */
+    SchemaSensor(std::string uid) : BaseSensor(uid)
+    {
+        for (size_t i = 0; i < VALUES_COUNT; ++i) {
+            ValuesStorage[i].reset(Schema::Values[i].DType, Schema::Values[i].Default);
+        }
+        for (size_t i = 0; i < CONFIGS_COUNT; ++i) {
+            ConfigsStorage[i].reset(Schema::Configs[i].DType, Schema::Configs[i].Default);
+        }
+
+        Values.bind(Schema::Values.data(), ValuesStorage.data(), VALUES_COUNT, &findValue);
+        Configs.bind(Schema::Configs.data(), ConfigsStorage.data(), CONFIGS_COUNT, &findConfig);
+    }
+
+    // Field sets point into this object, so it must not be copied.
+    SchemaSensor(const SchemaSensor&) = delete;
+    SchemaSensor& operator=(const SchemaSensor&) = delete;
+};
+
 /**************************************************************************/
 // CREATE FUNCTIONS
 /**************************************************************************/
@@ -706,19 +1296,21 @@ T* createSensor(std::string uid) {
  * @param config The configuration string.
  * @throws Exceptions should be internally resolved to prevent program from crash.
  */
-void configSensor(BaseSensor *sensor, const std::string &config);
+void configSensor(BaseSensor *sensor, std::string_view config);
 
 /**
  * @brief Updates the sensor with new measurement data.
  * 
  * This function updates the sensor's parameters based on the provided update string.
- * The update string should follow the expected format (e.g. "Value=3.3").
+ * The update string should follow the expected format (e.g. "Value=3.3"), or be
+ * binary fields of the sensor values schema.
  * 
  * @param sensor Pointer to the sensor to be updated.
  * @param update The update string containing new sensor data.
+ * @param format The format of the update.
  * @throws Exceptions should be internally resolved to prevent program from crash.
  */
-void updateSensor(BaseSensor *sensor, const std::string &update);
+void updateSensor(BaseSensor *sensor, std::string_view update, WireFormat format = WireFormat::TEXT);
 
 /**
  * @brief Prints detailed information about the sensor.
@@ -761,4 +1353,15 @@ void drawSensor(BaseSensor *sensor);
  */
 void constructSensor(BaseSensor *sensor);
 
+/**
+ * @brief Destructs the sensor.
+ * 
+ * This function deletes the sensor's UI by calling the sensor's destruct() method.
+ * 
+ * @param sensor Pointer to the sensor to be destructed.
+ * @param deferred Flag if the widget is deleted by the next lv_timer_handler() (see BaseSensor::destruct).
+ * @throws Exceptions should be internally resolved to prevent program from crash.
+ */
+void destructSensor(BaseSensor *sensor, bool deferred);
+
 #endif //BASE_SENSOR_HPP
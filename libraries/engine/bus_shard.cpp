@@ -0,0 +1,416 @@
+/**
+ * @file bus_shard.cpp
+ * @brief Definition of the bus shard
+ *
+ * This source defines the sync protocol of one device link.
+ *
+ * @copyright 2025 MTA
+ * @author
+ * Ing. Jiri Konecny
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "bus_shard.hpp"
+#include "sensor_factory.hpp"
+#include "messenger.hpp"
+#include "parser.hpp"
+#include "helpers.hpp"
+#include "base_sensor.hpp"
+
+#include <algorithm>
+
+BusShard::BusShard(Messenger& link)
+ : Sensors(), Link(&link), OwnsLink(false), CaseSensitive(CASE_SENSITIVE_SYNC), Format(WireFormat::TEXT),
+   Sequence(), Subscribed(false), SequenceGap(false), LastFrameMs(0), Coalescer(), Checked(false), Checker(),
+   NextSync(0), Awaited(nullptr), Schedule(), Due(), Updates(nullptr), DroppedUpdates(0)
+{
+}
+
+BusShard::BusShard(Transport* transport)
+ : BusShard(*new Messenger(transport))
+{
+    OwnsLink = true;
+}
+
+BusShard::~BusShard() {
+    if (OwnsLink) delete Link;
+}
+
+void BusShard::setTransport(Transport* transport) {
+    Link->setTransport(transport);
+    Link->setFraming(Format == WireFormat::BINARY, Checked);
+}
+
+bool BusShard::init(bool fromRequest) {
+    if (!Link->getTransport()) {
+        if (OwnsLink) return false; // Extra buses have no default transport.
+        Link->setTransport(&getDefaultTransport());
+    }
+    Link->begin();
+    if (!fromRequest) {
+        createSensorList(Sensors);
+    }
+    else {
+        FrameBuilder &request = Link->compose().command("INIT");
+        if (BINARY_SYNC) {
+            request.field("format", WireFormatName(WireFormat::BINARY));
+        }
+        if (CHECKED_SYNC) {
+            request.field("check", FRAME_CHECK_NAME);
+        }
+        Link->send();
+        std::string response;
+        Link->receive(response, UART_INIT_TIMEOUT);
+        if (response.empty() || response[0] != '?') {
+            return false;
+        }
+        response.erase(0, 1);
+        Format = ParseWireFormat(response);
+        setFrameCheck(ParseFrameCheck(response));
+        logMessage("Using %s%s update frames.\n", Checked ? "checked " : "", WireFormatName(Format));
+        createSensorList(Sensors, response);
+    }
+    unsigned long now = getTimeMs();
+    Index.clear();
+    for (auto* sensor : Sensors) {
+        sensor->Link = Link;
+        sensor->Health.reset(now);
+        Index.insert(sensor->UID, sensor);
+    }
+    reschedule(now);
+    setCaseSensitive(CaseSensitive);
+    if (SUBSCRIBE_SYNC) subscribe();
+    return true;
+}
+
+BaseSensor* BusShard::getSensor(std::string_view uid) const {
+    return Index.find(uid);
+}
+
+void BusShard::addSensor(BaseSensor* sensor) {
+    if (!sensor) return;
+    sensor->Link = Link;
+    sensor->Health.reset(getTimeMs());
+    sensor->setCaseSensitive(CaseSensitive);
+    Sensors.push_back(sensor);
+    Index.insert(sensor->UID, sensor);
+    Schedule.add(Sensors.size() - 1, getTimeMs());
+}
+
+void BusShard::clear() {
+    Sensors.clear();
+    Index.clear();
+    Schedule.clear();
+    NextSync = 0;
+}
+
+void BusShard::setSamplePeriod(BaseSensor* sensor, unsigned long periodMs) {
+    if (!sensor) return;
+    sensor->SamplePeriodMs = periodMs;
+    // Only this sensor is due at once to start its new period, the others keep their deadlines.
+    auto position = std::find(Sensors.begin(), Sensors.end(), sensor);
+    if (position != Sensors.end()) {
+        Schedule.reschedule(static_cast<size_t>(position - Sensors.begin()), getTimeMs());
+    }
+}
+
+void BusShard::reschedule(unsigned long now) {
+    Schedule.clear();
+    for (size_t i = 0; i < Sensors.size(); ++i) Schedule.add(i, now);
+}
+
+void BusShard::sync(BaseSensor* sensor) {
+    if (!sensor) return;
+    sensor->synchronize();
+    unsigned long now = getTimeMs();
+    if (!sensor->Health.due(now)) {
+        return; // Unresponsive sensor backing off, never wait for it.
+    }
+    Link->compose().command("UPDATE").field("id", sensor->UID);
+    Link->send();
+
+    // Lines received meanwhile (e.g. pushed frames) are ingested as well, until the reply.
+    Awaited = sensor;
+    unsigned long deadline = now + sensor->TimeoutMs;
+    std::string_view batch;
+    while (Awaited && static_cast<long>(deadline - getTimeMs()) > 0) {
+        if (Link->wait(batch, deadline - getTimeMs())) ingest(batch);
+    }
+    Coalescer.flush();
+    if (Awaited) {
+        Awaited = nullptr;
+        unresponsive(sensor, getTimeMs());
+    }
+}
+
+void BusShard::beginSyncAll() {
+    NextSync = 0;
+}
+
+bool BusShard::syncStep() {
+    // Requests go out back to back, up to MAX_PENDING_REQUESTS at once, and replies are
+    // matched by their request number as they arrive, in any order. Sensors backing off
+    // are skipped, each request waits only for the deadline of its sensor.
+    unsigned long now = getTimeMs();
+    while (NextSync < Sensors.size() && Link->outstanding() < MAX_PENDING_REQUESTS) {
+        BaseSensor* sensor = Sensors[NextSync];
+        if (!sensor->Health.due(now)) {
+            ++NextSync;
+            continue;
+        }
+        sensor->beginSync();
+        Link->compose().command("UPDATE").field("id", sensor->UID);
+        if (Link->request(NextSync, sensor->TimeoutMs) < 0) {
+            // Not sent (no link, frame overflow), it backs off as a request timed out.
+            logMessage("Sync request of sensor %s not sent.\n", sensor->UID.c_str());
+            unresponsive(sensor, now);
+        }
+        ++NextSync;
+    }
+    std::string_view batch;
+    while (Link->poll(batch)) {
+        ingest(batch);
+    }
+    expireRequests();
+    if (NextSync < Sensors.size() || Link->outstanding() > 0) {
+        return true;
+    }
+    Coalescer.flush();
+    return false;
+}
+
+void BusShard::setFrameCheck(bool enabled) {
+    Checked = enabled;
+    Checker.reset();
+    Link->setFraming(Format == WireFormat::BINARY, Checked);
+}
+
+void BusShard::subscribe() {
+    for (auto* sensor : Sensors) sendSubscribe(sensor);
+    Subscribed = true;
+    LastFrameMs = getTimeMs();
+}
+
+void BusShard::subscribe(BaseSensor* sensor, unsigned long periodMs) {
+    if (!sensor) return;
+    sensor->SubscribePeriodMs = periodMs;
+    if (Subscribed) sendSubscribe(sensor);
+}
+
+void BusShard::unsubscribe() {
+    Link->send("?UNSUBSCRIBE");
+    Subscribed = false;
+}
+
+void BusShard::sendSubscribe(const BaseSensor* sensor) {
+    Link->compose().command("SUBSCRIBE")
+        .field("id", sensor->UID)
+        .field("period", static_cast<int>(sensor->SubscribePeriodMs));
+    Link->send();
+}
+
+void BusShard::resync() {
+    unsigned long now = getTimeMs();
+    if (Subscribed) {
+        // Frames are pushed by the device, only lost ones cost a request: a sequence gap
+        // asks for a full update, a silent device is subscribed again (e.g. after reset).
+        if (SequenceGap) {
+            Link->send("?UPDATE");
+            SequenceGap = false;
+        }
+        if (now - LastFrameMs >= SUBSCRIBE_TIMEOUT) {
+            logMessage("No frames pushed for %d ms, subscribing again.\n", SUBSCRIBE_TIMEOUT);
+            subscribe();
+        }
+    }
+    else {
+        requestDue(now);
+    }
+
+    // Apply whatever was received meanwhile, never wait for it.
+    std::string_view batch;
+    while (Link->poll(batch)) {
+        ingest(batch);
+    }
+    Coalescer.flush();
+
+    // Sensors silent for a while are asked directly, their replies are ingested by a later
+    // resync. Unresponsive ones back off, so dead sensors cost no waiting at all.
+    expireRequests();
+    now = getTimeMs(); // Frames just ingested are newer than the start of the resync.
+    for (size_t i = 0; i < Sensors.size() && Link->outstanding() < MAX_PENDING_REQUESTS; ++i) {
+        BaseSensor* sensor = Sensors[i];
+        SensorHealth& health = sensor->Health;
+        unsigned long silence = SENSOR_SILENCE_MS + (Subscribed ? sensor->SubscribePeriodMs : sensor->SamplePeriodMs);
+        if (health.probing() || !health.due(now) || !health.silent(now, silence)) {
+            continue;
+        }
+        Link->compose().command("UPDATE").field("id", sensor->UID);
+        if (Link->request(i, sensor->TimeoutMs) >= 0) {
+            health.probe();
+        }
+    }
+}
+
+void BusShard::requestDue(unsigned long now) {
+    // Only the sensors due by their sample period are requested, all in one frame
+    // ("?UPDATE&id=8,9"), so slow sensors no longer cost the bus what fast ones need.
+    Due.clear();
+    size_t index;
+    unsigned long dueMs;
+    while (Schedule.pop(now, index, dueMs)) {
+        BaseSensor* sensor = Sensors[index];
+        unsigned long period = sensor->SamplePeriodMs > 0 ? sensor->SamplePeriodMs : 1;
+        // A late sensor restarts its period from now, missed samples are not caught up.
+        unsigned long next = dueMs + period;
+        Schedule.add(index, static_cast<long>(next - now) > 0 ? next : now + period);
+        if (sensor->Health.due(now)) Due.push_back(index);
+    }
+    if (Due.empty()) {
+        return;
+    }
+    FrameBuilder &request = Link->compose().command("UPDATE");
+    bool listed = Due.size() < Sensors.size();
+    if (listed) {
+        request.append("&id=");
+        for (size_t i = 0; i < Due.size(); ++i) {
+            if (i > 0) request.append(',');
+            request.append(std::string_view(Sensors[Due[i]]->UID));
+        }
+        listed = !request.overflow();
+        if (!listed) request.command("UPDATE"); // Too many to list, all are requested.
+    }
+    // Acknowledge the last applied update, the device then sends only fields changed since,
+    // of the listed sensors or of all.
+    if (DELTA_SYNC && Sequence.acked() >= 0) {
+        request.field("ack", static_cast<int>(Sequence.acked()));
+    }
+    Link->send();
+}
+
+void BusShard::expireRequests() {
+    unsigned long now = getTimeMs();
+    Link->expire([this, now](size_t index) {
+        if (index >= Sensors.size()) return;
+        BaseSensor* sensor = Sensors[index];
+        // Replies echoing the request number completed it in ingest(), only unanswered requests
+        // expire here. Fallback for devices not echoing "req": their reply is a plain update frame,
+        // so a sensor heard from within its deadline counts as answered. Such a request holds its
+        // slot of MAX_PENDING_REQUESTS until the deadline, the sync is then no longer pipelined.
+        if (sensor->Health.silent(now, sensor->TimeoutMs)) {
+            unresponsive(sensor, now);
+        } else {
+            responsive(sensor, now);
+        }
+    });
+}
+
+void BusShard::ingest(std::string_view batch) {
+    // Each frame is parsed as a view into the receive buffer, only the data of update
+    // frames are copied by the coalescing stage.
+    long seq = -1;
+    size_t updates = 0;
+    unsigned long now = getTimeMs();
+    auto handle = [this, &seq, &updates, now](std::string_view frame, WireFormat format) {
+        SensorMetadata metadata = format == WireFormat::BINARY ? ParseBinaryMetadata(frame)
+                                                               : ParseMetadata(frame, CaseSensitive);
+        if (metadata.Req < 0) {
+            ++updates;
+            if (metadata.Seq >= 0) seq = metadata.Seq;
+            if (metadata.UID.empty() && metadata.Seq >= 0) return; // "?seq=N", nothing changed.
+        }
+        size_t index;
+        bool reply = metadata.Req >= 0 && Link->complete(metadata.Req, index) && index < Sensors.size();
+        BaseSensor* replying = reply ? Sensors[index] : nullptr;
+        if (!replying && Awaited && metadata.Req < 0 && metadata.UID == Awaited->UID) {
+            replying = Awaited; // Reply to the sync() request, not numbered.
+        }
+        if (replying && !Updates) {
+            Coalescer.flush(); // Older frames must not overwrite the reply.
+            if (replying->receiveValues(metadata)) {
+                if (replying == Awaited) Awaited = nullptr;
+                return; // Reply to the syncStep() or sync() request of the sensor.
+            }
+        }
+        BaseSensor* sensor = getSensor(metadata.UID);
+        if (Updates) {
+            publish(sensor, metadata, reply, now);
+            return;
+        }
+        if (sensor) sensor->markResponsive(now);
+        Coalescer.push(sensor, metadata);
+    };
+    if (Checked) {
+        Checker.forEach(batch, Format, handle); // Corrupted frames are dropped and counted.
+    } else {
+        forEachWireFrame(batch, Format, handle);
+    }
+    if (updates == 0) {
+        return; // Empty line or request replies only.
+    }
+    LastFrameMs = now;
+
+    // Deltas must follow the acknowledged update, after a gap the next request asks for the full update.
+    long acked = Sequence.acked();
+    if (!Sequence.received(seq)) {
+        logMessage("Update sequence gap (%ld after %ld), requesting full update.\n", seq, acked);
+        SequenceGap = Subscribed;
+    }
+}
+
+void BusShard::setCaseSensitive(bool caseSensitive) {
+    CaseSensitive = caseSensitive;
+    for (auto* sensor : Sensors) sensor->setCaseSensitive(caseSensitive);
+}
+
+void BusShard::responsive(BaseSensor* sensor, unsigned long now) {
+    if (!Updates) {
+        sensor->markResponsive(now);
+    } else if (sensor->Health.replied(now)) {
+        post(sensor, UpdateKind::ONLINE, 0, NumericValue{0}, now);
+    }
+}
+
+void BusShard::unresponsive(BaseSensor* sensor, unsigned long now) {
+    if (!Updates) {
+        sensor->markUnresponsive(now);
+    } else if (sensor->Health.timedOut(now, sensor->TimeoutMs)) {
+        post(sensor, UpdateKind::OFFLINE, 0, NumericValue{0}, now);
+    }
+}
+
+void BusShard::publish(BaseSensor* sensor, const SensorMetadata& metadata, bool reply, unsigned long now) {
+    // The frame is parsed here, the queue reader only stores the typed values. Every value
+    // is queued in order, the reader applies them all, so the newest one wins.
+    if (!sensor || !CheckMetadata(&metadata)) {
+        Coalescer.push(sensor, metadata); // Only counted as dropped.
+        return;
+    }
+    responsive(sensor, now);
+    size_t rejected = sensor->parseValues(metadata.Data, metadata.Format,
+        [this, sensor, now](size_t field, const NumericValue& number) {
+            post(sensor, UpdateKind::VALUE, field, number, now);
+        });
+    if (rejected > 0) {
+        NumericValue count;
+        count.Int = static_cast<int>(rejected);
+        post(sensor, UpdateKind::REJECTED, 0, count, now);
+    }
+    SensorStatus status;
+    if (reply && BaseSensor::parseStatus(metadata.Status, status)) {
+        NumericValue number;
+        number.Int = static_cast<int>(status);
+        post(sensor, UpdateKind::STATUS, 0, number, now);
+    }
+}
+
+void BusShard::post(BaseSensor* sensor, UpdateKind kind, size_t field, NumericValue number, unsigned long now) {
+    // The reader drains once per UI loop, waiting for it would overrun the receive queue,
+    // so a full queue drops the update like the coalescer drops frames.
+    SensorUpdate update{sensor, kind, static_cast<uint8_t>(field), number, now};
+    if (!Updates->push(update)) {
+        ++DroppedUpdates;
+    }
+}
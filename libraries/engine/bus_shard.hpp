@@ -0,0 +1,125 @@
+/**
+ * @file bus_shard.hpp
+ * @brief Declaration of the bus shard, the sensors and sync state of one device link.
+ *
+ * Every bus (UART, USB-CDC, ...) has its own messenger, receive queue (filled by the
+ * transport's receive task) and protocol state, so a slow or silent bus never delays
+ * the others. SensorManager merges the sensors of all shards into one registry.
+ *
+ * @copyright 2025 MTA
+ * @author
+ * Ing. Jiri Konecny
+ */
+#ifndef BUS_SHARD_HPP
+#define BUS_SHARD_HPP
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <string_view>
+
+#include "parser.hpp"
+#include "coalescer.hpp"
+#include "frame_check.hpp"
+#include "sensor_index.hpp"
+#include "sample_scheduler.hpp"
+#include "update_sequence.hpp"
+#include "sensor_update.hpp"
+
+class BaseSensor;
+class Messenger;
+class Transport;
+
+class BusShard {
+public:
+    // Shard over an existing messenger (the global one of the primary bus), not owned
+    explicit BusShard(Messenger& link);
+    // Shard with its own messenger over the transport, the transport is not owned
+    explicit BusShard(Transport* transport);
+    ~BusShard();
+
+    // Deleted copy semantics
+    BusShard(const BusShard&) = delete;
+    BusShard& operator=(const BusShard&) = delete;
+
+    // Link to the device
+    Messenger& getLink() const { return *Link; }
+    void setTransport(Transport* transport);
+
+    // Create the sensors from the fixed list, or from the ?INIT response of the device.
+    // Returns false if the device did not answer with a valid sensor list.
+    bool init(bool fromRequest);
+
+    // Sensors of the bus, owned by SensorManager
+    const std::vector<BaseSensor*>& getSensors() const { return Sensors; }
+    BaseSensor* getSensor(std::string_view uid) const;
+    void addSensor(BaseSensor* sensor);
+    void clear();
+
+    // Request the sensors due by their sample period (or in push mode only ingest updates), never waits
+    void resync();
+    void setSamplePeriod(BaseSensor* sensor, unsigned long periodMs);
+
+    // Blocking sync of one sensor, its reply is split and checked as the frames of resync()
+    void sync(BaseSensor* sensor);
+
+    // Pipelined sync of all sensors in steps, so the buses are synchronized side by side:
+    // beginSyncAll() then syncStep() until it returns false
+    void beginSyncAll();
+    bool syncStep();
+
+    void setCaseSensitive(bool caseSensitive);
+    WireFormat getWireFormat() const { return Format; }
+
+    void subscribe();
+    void subscribe(BaseSensor* sensor, unsigned long periodMs);
+    void unsubscribe();
+    bool isSubscribed() const { return Subscribed; }
+
+    void setFrameCheck(bool enabled);
+    bool isFrameChecked() const { return Checked; }
+    FrameCheckStats getFrameCheckStats() const { return Checker.stats(); }
+
+    // Threaded mode: received values, statuses and health changes are queued as typed updates
+    // instead of being applied, the sensors are then touched by the queue reader only.
+    // A full queue drops the update, counted by getDroppedUpdates().
+    void setUpdateQueue(UpdateQueue* queue) { Updates = queue; }
+    unsigned long getDroppedUpdates() const { return DroppedUpdates; }
+
+    void setCoalescing(bool enabled) { Coalescer.setEnabled(enabled); }
+    unsigned long getCoalescedFrames() const { return Coalescer.coalesced(); }
+    unsigned long getDroppedFrames() const { return Coalescer.dropped(); }
+
+private:
+    std::vector<BaseSensor*> Sensors; ///< Sensors of the bus.
+    SensorIndex Index;    ///< Sensors of the bus by UID, for the frame dispatch.
+    Messenger* Link;      ///< Messenger of the bus.
+    bool OwnsLink;        ///< Flag if the messenger is created by the shard.
+    bool CaseSensitive;   ///< Flag if keys of received frames are matched case-sensitive.
+    WireFormat Format;    ///< Format of the update frames confirmed by the device.
+    UpdateSequence Sequence; ///< Last applied update batch, acknowledged for delta frames.
+    std::atomic<bool> Subscribed; ///< Flag if the device pushes update frames, read by isSubscribed() on any thread.
+    bool SequenceGap;     ///< Flag if pushed frames were lost, a full update is requested.
+    unsigned long LastFrameMs; ///< Time the last update frame was received, by the resyncing thread only.
+    UpdateCoalescer Coalescer; ///< Coalescing of received update frames.
+    bool Checked;         ///< Flag if only CRC-checked frames are accepted.
+    FrameChecker Checker; ///< Validation of the checked frames.
+    size_t NextSync;      ///< Index of the next sensor requested by syncStep().
+    BaseSensor* Awaited;  ///< Sensor waiting for its sync() reply, nullptr if none.
+    SampleScheduler Schedule; ///< Sample deadlines of the sensors, polled by resync().
+    std::vector<size_t> Due;  ///< Sensors requested by one resync(), kept for its capacity.
+    UpdateQueue* Updates;     ///< Queue of typed updates in threaded mode, nullptr applies them in place.
+    std::atomic<unsigned long> DroppedUpdates; ///< Updates dropped on a full queue.
+
+    void ingest(std::string_view batch);
+    void expireRequests();
+    void requestDue(unsigned long now);
+    void reschedule(unsigned long now);
+    void responsive(BaseSensor* sensor, unsigned long now);
+    void unresponsive(BaseSensor* sensor, unsigned long now);
+    void publish(BaseSensor* sensor, const SensorMetadata& metadata, bool reply, unsigned long now);
+    void post(BaseSensor* sensor, UpdateKind kind, size_t field, NumericValue number, unsigned long now);
+    void sendSubscribe(const BaseSensor* sensor);
+};
+
+#endif // BUS_SHARD_HPP
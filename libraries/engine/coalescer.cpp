@@ -0,0 +1,71 @@
+/**
+ * @file coalescer.cpp
+ * @brief Definition of the coalescing of received update frames.
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "coalescer.hpp"
+#include "base_sensor.hpp" ///< BaseSensor.
+
+void UpdateCoalescer::setEnabled(bool enabled)
+{
+    flush();
+    Enabled = enabled;
+}
+
+void UpdateCoalescer::push(BaseSensor *sensor, const SensorMetadata &metadata)
+{
+    if (!sensor || !CheckMetadata(&metadata)) {
+        ++Dropped; // Unknown sensor or malformed frame.
+        return;
+    }
+    if (!Enabled) {
+        updateSensor(sensor, metadata.Data, metadata.Format);
+        return;
+    }
+    if (Frames.size() == COALESCE_FRAMES) {
+        flush();
+    }
+    Frames.push_back({sensor, Data.size(), metadata.Data.size(), metadata.Format});
+    Data.append(metadata.Data.data(), metadata.Data.size());
+}
+
+void UpdateCoalescer::flush()
+{
+    // Sensors keeping every sample get all frames in order.
+    for (const Frame &frame : Frames) {
+        if (frame.Sensor->HistoryAllSamples) {
+            updateSensor(frame.Sensor, view(frame), frame.Format);
+        }
+    }
+
+    // The others from the newest, each value once.
+    Masks.clear();
+    for (auto it = Frames.rbegin(); it != Frames.rend(); ++it) {
+        if (it->Sensor->HistoryAllSamples) {
+            continue;
+        }
+        if (it->Sensor->coalesce(view(*it), it->Format, mask(it->Sensor)) == 0) {
+            ++Coalesced; // All values superseded by newer frames.
+        }
+    }
+
+    Frames.clear();
+    Data.clear();
+}
+
+uint32_t &UpdateCoalescer::mask(BaseSensor *sensor)
+{
+    for (auto &entry : Masks) {
+        if (entry.first == sensor) {
+            return entry.second;
+        }
+    }
+    Masks.emplace_back(sensor, 0);
+    return Masks.back().second;
+}
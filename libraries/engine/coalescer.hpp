@@ -0,0 +1,111 @@
+/**
+ * @file coalescer.hpp
+ * @brief Coalescing of received update frames, the latest value wins.
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#ifndef COALESCER_HPP
+#define COALESCER_HPP
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "config.hpp" ///< Configuration.
+#include "parser.hpp" ///< SensorMetadata.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class BaseSensor;
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @class UpdateCoalescer
+ * @brief Holds update frames received by one resync and applies only their newest values.
+ *
+ * When frames arrive faster than they are drawn, the intermediate values are never
+ * seen. The held frames are applied from the newest, so the values of older frames are
+ * not even parsed once newer frames carried them. Sensors with HistoryAllSamples get
+ * all frames applied in order, so every sample reaches their history.
+ *
+ * Frame bytes are copied, the buffers keep their capacity and are reused.
+ */
+class UpdateCoalescer
+{
+public:
+    UpdateCoalescer() : Enabled(COALESCE_SYNC), Coalesced(0), Dropped(0)
+    {
+        Frames.reserve(COALESCE_FRAMES);
+    }
+
+    /**
+     * @brief Enable or disable coalescing, a disabled stage applies frames at once.
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * @brief Queue update frame of the sensor.
+     *
+     * @param sensor The sensor of the frame, nullptr if unknown.
+     * @param metadata The parsed frame.
+     */
+    void push(BaseSensor *sensor, const SensorMetadata &metadata);
+
+    /**
+     * @brief Apply the queued frames.
+     */
+    void flush();
+
+    /**
+     * @brief Get number of queued frames.
+     */
+    size_t pending() const { return Frames.size(); }
+
+    /**
+     * @brief Get number of frames not applied because newer frames carried all their values.
+     */
+    unsigned long coalesced() const { return Coalesced; }
+
+    /**
+     * @brief Get number of frames dropped as malformed or of unknown sensor.
+     */
+    unsigned long dropped() const { return Dropped; }
+
+private:
+    /**
+     * @brief Queued frame, its data are stored in Data.
+     */
+    struct Frame
+    {
+        BaseSensor *Sensor; ///< Sensor of the frame.
+        size_t Offset;      ///< Offset of the frame data.
+        size_t Length;      ///< Length of the frame data.
+        WireFormat Format;  ///< Format of the frame data.
+    };
+
+    bool Enabled;                                           ///< Flag if frames are coalesced.
+    std::vector<Frame> Frames;                              ///< Queued frames, in arrival order.
+    std::string Data;                                       ///< Data of the queued frames.
+    std::vector<std::pair<BaseSensor*, uint32_t>> Masks;    ///< Applied value positions of each sensor.
+    std::atomic<unsigned long> Coalesced;                   ///< Number of superseded frames, read from any thread.
+    std::atomic<unsigned long> Dropped;                     ///< Number of dropped frames, read from any thread.
+
+    std::string_view view(const Frame &frame) const
+    {
+        return std::string_view(Data).substr(frame.Offset, frame.Length);
+    }
+
+    uint32_t &mask(BaseSensor *sensor);
+};
+
+#endif // COALESCER_HPP
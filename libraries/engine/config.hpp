@@ -12,19 +12,77 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
-/// Uncomment to enable logging for Arduino-based environments
+/// Uncomment to enable logging for standard console applications (PC/Linux),
+/// host builds can define it on the command line instead (-DSTDIO_H)
+//#define STDIO_H 
+
+/// Arduino-based environments are used unless STDIO_H is defined
+#ifndef STDIO_H
 #define ARDUINO_H 
+#endif
 #define UART1_PORT 0
 #define UART1_BAUDRATE 115200
 #define UART1_RX -1
 #define UART1_TX -1
-#define UART_TIMEOUT 100
+#define UART_TIMEOUT 100        ///< Response timeout of update request [ms].
+#define UART_INIT_TIMEOUT 1000  ///< Response timeout of init request [ms].
+#define UART_RX_BUFFER 2048     ///< Receive ring buffer size, power of two [B].
+#define UART_FRAME_MAX 1024     ///< Maximal received frame (response line) length [B].
+#define FRAME_DELIMITER '\n'    ///< Delimiter of received frames.
+#define TX_FRAME_MAX 256        ///< Maximal sent frame (request) length, see FrameBuilder [B].
+#define MAX_PENDING_REQUESTS 16 ///< Numbered requests awaiting reply at once (pipelined sync).
+
+///Each resync() requests only the sensors due by their sample period (see BaseSensor::SamplePeriodMs), in one frame
+#define SAMPLE_PERIOD_MS 100        ///< Default request period of a polled sensor [ms].
 
-///Set whatever the sync is case sensitive
+///Per-sensor reply deadlines and backoff of unresponsive sensors (see SensorHealth)
+#define SENSOR_TIMEOUT UART_TIMEOUT ///< Default reply deadline of a sensor request [ms].
+#define SENSOR_SILENCE_MS 1000      ///< A sensor without update frames this long is probed by its own request [ms].
+#define SENSOR_OFFLINE_FAILURES 3   ///< Timeouts in a row making a sensor OFFLINE.
+#define SENSOR_BACKOFF_MAX 8000     ///< Longest wait between requests of an unresponsive sensor [ms].
+
+///Extra buses with their own sensors (see SensorManager::addBus), each synchronized independently
+#define UART2_BUS false             ///< Second UART bus.
+#define UART2_PORT 1
+#define UART2_BAUDRATE 115200
+#define UART2_RX -1
+#define UART2_TX -1
+#define USB_CDC_BUS false           ///< USB-CDC bus, the log output must then go elsewhere than Serial.
+
+///Set whatever the sync is case sensitive (default, see SensorManager/BaseSensor::setCaseSensitive)
 #define CASE_SENSITIVE_SYNC true
 
+///Request the binary update frames during ?INIT (used only if the device confirms it, see WireFormat)
+#define BINARY_SYNC false
+
+///Request CRC-checked frames during ?INIT (used only if the device confirms it, see frame_check.hpp)
+#define CHECKED_SYNC false
+
+///Acknowledge sequence numbers of update frames, so the device may send only changed fields (delta frames).
+///Changes the ?UPDATE requests, enable only for devices supporting the acknowledgement.
+#define DELTA_SYNC false
+
+///Let the device push update frames (?SUBSCRIBE) instead of polling them with ?UPDATE (see SensorManager::subscribe)
+#define SUBSCRIBE_SYNC false
+#define SUBSCRIBE_PERIOD_MS 100     ///< Default push period of a sensor, 0 pushes on change only [ms].
+#define SUBSCRIBE_TIMEOUT 2000      ///< Subscription is renewed if nothing was pushed for this long [ms].
+
+///Coalesce update frames received by one resync, only the newest value of each field is applied.
+///Without COALESCE_HISTORY the superseded samples are missing in the history, enable per build.
+#define COALESCE_SYNC false
+#define COALESCE_FRAMES 64          ///< Frames held by the coalescing stage before they are applied.
+#define COALESCE_HISTORY false      ///< Feed every received sample into history (see BaseSensor::HistoryAllSamples).
+
+///Widgets of the sensors are constructed on first show, over the budget the least recently shown hidden ones are deleted
+#define WIDGET_HEAP_BUDGET (64U * 1024U) ///< Heap for widgets of the sensors [B], 0 keeps all constructed.
+
+///Threaded mode (see SensorManager::startThreaded): a communication task per bus syncs it, redraw() applies their typed updates
+#define THREADED_SYNC false
+#define UPDATE_QUEUE_CAP 256        ///< Updates queued for the UI thread by one bus, power of two.
+#define COMM_CYCLE_MS 5             ///< Pause of the communication task between resyncs [ms].
+#define COMM_TASK_CORE 0            ///< ESP32-S3 core of the communication task, the Arduino loop runs on core 1.
+#define COMM_TASK_STACK 8192        ///< Stack of the communication task [B].
+#define COMM_TASK_PRIORITY 2        ///< FreeRTOS priority of the communication task.
 
-/// Uncomment to enable logging for standard console applications (PC/Linux)
-//#define STDIO_H 
 
 #endif // CONFIG_H 
\ No newline at end of file
@@ -0,0 +1,216 @@
+/**
+ * @file field_schema.hpp
+ * @brief Compile-time field schemas of sensor values and configurations.
+ *
+ * Every sensor class declares its values and configurations as a constexpr table of
+ * FieldSchema entries. From the table a FieldLookup is generated at compile time, which
+ * maps an incoming key to the field position by a perfect hash (one hash, one compare).
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#ifndef FIELD_SCHEMA_HPP
+#define FIELD_SCHEMA_HPP
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "helpers.hpp"  ///< For hashKey
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @enum DataType
+ * @brief Enumeration representing possible parametrs data types.
+ *
+ * - INT: int.
+ * - DOUBLE: double.
+*  - FLOAT: float.
+ * - STRING: string.
+ */
+enum class DataType {
+    INT,
+    DOUBLE,
+    FLOAT,
+    STRING
+};
+
+/**
+ * @union NumericValue
+ * @brief Native storage of a numeric parameter value.
+ */
+union NumericValue
+{
+    int Int;       ///< Value of INT parameter.
+    float Float;   ///< Value of FLOAT parameter.
+    double Double; ///< Value of DOUBLE parameter.
+};
+
+/**
+ * @struct FieldSchema
+ * @brief Compile-time description of one sensor value or configuration.
+ */
+struct FieldSchema
+{
+    const char *Name;    ///< Field key, as used in frames.
+    const char *Unit;    ///< Field unit.
+    DataType DType;      ///< Field data type.
+    const char *Default; ///< Default value.
+};
+
+/**
+ * @class FieldLookup
+ * @brief Perfect-hash lookup of field positions, generated at compile time.
+ *
+ * The constructor searches for a hash seed which places every field name of the schema
+ * into its own slot, so a lookup is a single hash, a single slot read and a single
+ * name comparison. A second table is built the same way from case-folded names for
+ * case-insensitive lookups, incoming keys are folded while hashing, never copied.
+ *
+ * @tparam N Number of fields in the schema.
+ */
+template <size_t N>
+class FieldLookup
+{
+public:
+    /**
+     * @brief Number of hash slots (power of two, at least twice the field count).
+     */
+    static constexpr size_t SLOTS = [] {
+        size_t slots = 2;
+        while (slots < N * 2) {
+            slots <<= 1;
+        }
+        return slots;
+    }();
+
+    /**
+     * @brief Builds the lookup of the given schema.
+     *
+     * @param schema The field schema.
+     */
+    constexpr FieldLookup(const std::array<FieldSchema, N> &schema) : Names(), Exact(), Folded()
+    {
+        for (size_t i = 0; i < N; ++i) {
+            Names[i] = schema[i].Name;
+        }
+        Exact.build(Names, true);
+        Folded.build(Names, false);
+    }
+
+    /**
+     * @brief Find position of the field with given name.
+     *
+     * @param key The field name.
+     * @param caseSensitive Flag if the name is matched case-sensitive.
+     * @return The field position, or -1 if the schema has no such field.
+     */
+    constexpr int find(std::string_view key, bool caseSensitive = true) const
+    {
+        if (N == 0) {
+            return -1;
+        }
+        const Table &table = caseSensitive ? Exact : Folded;
+        uint8_t slot = table.Slots[hashKey(key, table.Seed, caseSensitive) & (SLOTS - 1)];
+        if (slot == 0 || !equals(Names[slot - 1], key, caseSensitive)) {
+            return -1;
+        }
+        return slot - 1;
+    }
+
+    /**
+     * @brief Check if collision-free seeds were found for the schema.
+     */
+    constexpr bool isPerfect() const { return Exact.Perfect && Folded.Perfect; }
+
+private:
+    /**
+     * @brief Hash table of field positions.
+     */
+    struct Table
+    {
+        std::array<uint8_t, SLOTS> Slots; ///< Field position + 1, 0 marks empty slot.
+        uint32_t Seed;                    ///< Hash seed.
+        bool Perfect;                     ///< Flag if every field has its own slot.
+
+        constexpr Table() : Slots(), Seed(0), Perfect(false) {}
+
+        /**
+         * @brief Search for a seed which gives every field its own slot.
+         */
+        constexpr void build(const std::array<std::string_view, N> &names, bool caseSensitive)
+        {
+            for (uint32_t seed = 0; seed < 4096 && !Perfect; ++seed) {
+                Seed = seed;
+                Perfect = place(names, seed, caseSensitive);
+            }
+        }
+
+        /**
+         * @brief Try to place all fields using the given seed.
+         *
+         * @return true if no two fields share a slot, false otherwise.
+         */
+        constexpr bool place(const std::array<std::string_view, N> &names, uint32_t seed, bool caseSensitive)
+        {
+            for (size_t s = 0; s < SLOTS; ++s) {
+                Slots[s] = 0;
+            }
+            for (size_t i = 0; i < N; ++i) {
+                size_t s = hashKey(names[i], seed, caseSensitive) & (SLOTS - 1);
+                if (Slots[s] != 0) {
+                    return false;
+                }
+                Slots[s] = static_cast<uint8_t>(i + 1);
+            }
+            return true;
+        }
+    };
+
+    std::array<std::string_view, N> Names; ///< Field names in the schema order.
+    Table Exact;                           ///< Case-sensitive table.
+    Table Folded;                          ///< Case-insensitive table.
+
+    /**
+     * @brief Compare field name with the key.
+     */
+    static constexpr bool equals(std::string_view name, std::string_view key, bool caseSensitive)
+    {
+        if (caseSensitive || name.size() != key.size()) {
+            return name == key;
+        }
+        for (size_t i = 0; i < name.size(); ++i) {
+            if (foldCase(name[i]) != foldCase(key[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Check if the schema has a STRING field.
+ *
+ * @param schema The field schema.
+ * @return true if a field is STRING, false otherwise.
+ */
+template <size_t N>
+constexpr bool hasStringField(const std::array<FieldSchema, N> &schema)
+{
+    for (size_t i = 0; i < N; ++i) {
+        if (schema[i].DType == DataType::STRING) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif // FIELD_SCHEMA_HPP
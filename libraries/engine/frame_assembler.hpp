@@ -0,0 +1,175 @@
+/**
+ * @file frame_assembler.hpp
+ * @brief Assembly of received bytes into delimited frames.
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#ifndef FRAME_ASSEMBLER_HPP
+#define FRAME_ASSEMBLER_HPP
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "parser.hpp"      ///< Frame markers.
+#include "frame_check.hpp" ///< Checked frame marker.
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @class FrameAssembler
+ * @brief Collects received bytes until the frame delimiter.
+ *
+ * A frame is one response line, it may batch several text and binary update frames.
+ * Binary payloads and checked frames are length-delimited, so a delimiter byte inside
+ * them does not end the frame. Their markers are recognized only once the format is agreed
+ * with the device (see setFraming), in plain text they are ordinary bytes. A frame longer
+ * than the capacity is dropped up to the next delimiter.
+ *
+ * @tparam N The maximal frame length.
+ */
+template <size_t N>
+class FrameAssembler
+{
+public:
+    FrameAssembler(char delimiter = '\n')
+     : Delimiter(delimiter), Length(0), Remaining(0), State(TEXT), Complete(false), Overflow(false),
+       Binary(false), Checked(false), Frames(0), Overflows(0) {}
+
+    /**
+     * @brief Set the length-delimited frames agreed with the device.
+     *
+     * @param binary Flag if binary update frames are used (BINARY_SYNC).
+     * @param checked Flag if CRC-checked frames are used (CHECKED_SYNC).
+     */
+    void setFraming(bool binary, bool checked)
+    {
+        Binary = binary;
+        Checked = checked;
+    }
+
+    /**
+     * @brief Consume one byte.
+     *
+     * @param c The received byte.
+     * @return true if the byte completed a frame, see frame().
+     */
+    bool feed(char c)
+    {
+        if (Complete) {
+            Length = 0;
+            Complete = false;
+        }
+
+        switch (State) {
+        case TEXT:
+            if (c == Delimiter) {
+                if (Overflow) {
+                    Overflow = false;
+                    Length = 0;
+                    return false;
+                }
+                Complete = true;
+                ++Frames;
+                return true;
+            }
+            if (Binary && c == BINARY_FRAME_MARKER) {
+                State = LENGTH;
+            } else if (Checked && c == CHECKED_FRAME_MARKER) {
+                State = CHECKED_LENGTH;
+            }
+            break;
+        case LENGTH:
+            Remaining = static_cast<uint8_t>(c);
+            State = Remaining ? PAYLOAD : TEXT;
+            break;
+        case CHECKED_LENGTH:
+            Remaining = static_cast<uint8_t>(c) + CHECKED_FRAME_OVERHEAD - 2; // Seq, payload and CRC follow.
+            State = PAYLOAD;
+            break;
+        case PAYLOAD:
+            if (--Remaining == 0) {
+                State = TEXT;
+            }
+            break;
+        }
+
+        if (Overflow) {
+            return false;
+        }
+        if (Length == N) {
+            Overflow = true; // Frame does not fit, drop it.
+            ++Overflows;
+            return false;
+        }
+        Buffer[Length++] = c;
+        return false;
+    }
+
+    /**
+     * @brief Consume bytes from the source until a frame is complete.
+     *
+     * @param source Any source with bool pop(char&), e.g. RingBuffer.
+     * @param frame The complete frame, valid until the next call.
+     * @return true if a frame is complete, false if the source ran out of bytes.
+     */
+    template <typename Source>
+    bool poll(Source &source, std::string_view &frame)
+    {
+        char c;
+        while (source.pop(c)) {
+            if (feed(c)) {
+                frame = this->frame();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Get the last complete frame, without the delimiter.
+     */
+    std::string_view frame() const { return Complete ? std::string_view(Buffer, Length) : std::string_view(); }
+
+    /**
+     * @brief Get number of complete frames.
+     */
+    size_t frames() const { return Frames; }
+
+    /**
+     * @brief Get number of frames dropped as too long.
+     */
+    size_t overflows() const { return Overflows; }
+
+private:
+    /**
+     * @brief Position within the frame.
+     */
+    enum Position {
+        TEXT,    ///< Text, or between binary frames.
+        LENGTH,  ///< Length byte of binary frame.
+        CHECKED_LENGTH, ///< Length byte of checked frame.
+        PAYLOAD  ///< Payload of binary or checked frame.
+    };
+
+    char Buffer[N];     ///< Frame storage.
+    char Delimiter;     ///< Frame delimiter.
+    size_t Length;      ///< Length of the stored frame.
+    size_t Remaining;   ///< Remaining bytes of binary payload.
+    Position State;     ///< Position within the frame.
+    bool Complete;      ///< Flag if the stored frame is complete.
+    bool Overflow;      ///< Flag if the current frame is dropped.
+    bool Binary;        ///< Flag if binary frames are length-delimited.
+    bool Checked;       ///< Flag if checked frames are length-delimited.
+    size_t Frames;      ///< Number of complete frames.
+    size_t Overflows;   ///< Number of dropped frames.
+};
+
+#endif // FRAME_ASSEMBLER_HPP
@@ -0,0 +1,147 @@
+/**
+ * @file frame_builder.hpp
+ * @brief Fixed-capacity builder of outbound frames.
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#ifndef FRAME_BUILDER_HPP
+#define FRAME_BUILDER_HPP
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "config.hpp"  ///< TX_FRAME_MAX.
+#include "helpers.hpp" ///< formatNumber.
+#include "parser.hpp"  ///< Frame markers.
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @class FrameBuilder
+ * @brief Builds a request (e.g. "?CONFIG&id=4&resolution=10") in a preallocated buffer.
+ *
+ * Values are formatted straight into the buffer, nothing is allocated. A frame longer
+ * than the capacity is marked as overflowed and must not be sent.
+ */
+class FrameBuilder
+{
+public:
+    FrameBuilder() : Length(0), Overflow(false) {}
+
+    /**
+     * @brief Discard the built frame.
+     */
+    FrameBuilder &clear()
+    {
+        Length = 0;
+        Overflow = false;
+        return *this;
+    }
+
+    /**
+     * @brief Start a new request frame (e.g. command("UPDATE") gives "?UPDATE").
+     */
+    FrameBuilder &command(std::string_view name)
+    {
+        clear();
+        append(TEXT_FRAME_MARKER);
+        return append(name);
+    }
+
+    /**
+     * @brief Append a character.
+     */
+    FrameBuilder &append(char c)
+    {
+        if (Length == TX_FRAME_MAX) {
+            Overflow = true;
+            return *this;
+        }
+        Buffer[Length++] = c;
+        return *this;
+    }
+
+    /**
+     * @brief Append a text.
+     */
+    FrameBuilder &append(std::string_view text)
+    {
+        if (text.size() > TX_FRAME_MAX - Length) {
+            Overflow = true;
+            return *this;
+        }
+        memcpy(Buffer + Length, text.data(), text.size());
+        Length += text.size();
+        return *this;
+    }
+
+    /**
+     * @brief Append an integer number.
+     */
+    FrameBuilder &append(int value)
+    {
+        return appendFormatted(formatNumber(Buffer + Length, TX_FRAME_MAX - Length + 1, value));
+    }
+
+    /**
+     * @brief Append a floating point number.
+     *
+     * @param value The value.
+     * @param decimals The number of decimal places, negative for automatic precision.
+     */
+    FrameBuilder &append(double value, int decimals = -1)
+    {
+        return appendFormatted(formatNumber(Buffer + Length, TX_FRAME_MAX - Length + 1, value, decimals));
+    }
+
+    /**
+     * @brief Append a field ("&key=value").
+     */
+    template <typename T>
+    FrameBuilder &field(std::string_view key, const T &value)
+    {
+        append('&');
+        append(key);
+        append('=');
+        return append(value);
+    }
+
+    /**
+     * @brief Get the built frame.
+     */
+    std::string_view view() const { return std::string_view(Buffer, Length); }
+
+    /**
+     * @brief Get length of the built frame.
+     */
+    size_t size() const { return Length; }
+
+    /**
+     * @brief Check if the frame did not fit, it is incomplete then.
+     */
+    bool overflow() const { return Overflow; }
+
+private:
+    char Buffer[TX_FRAME_MAX + 1]; ///< Frame storage, formatNumber() needs room for its terminator.
+    size_t Length;                 ///< Length of the built frame.
+    bool Overflow;                 ///< Flag if the frame did not fit.
+
+    FrameBuilder &appendFormatted(size_t length)
+    {
+        if (length == 0) {
+            Overflow = true; // formatNumber() writes nothing that does not fit.
+        }
+        Length += length;
+        return *this;
+    }
+};
+
+#endif // FRAME_BUILDER_HPP
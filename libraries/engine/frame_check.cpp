@@ -0,0 +1,69 @@
+/**
+ * @file frame_check.cpp
+ * @brief Definition of the CRC-checked framing.
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "frame_check.hpp"
+#include "helpers.hpp" ///< KeyValueToken, equalsKey.
+
+#include <array>
+
+/**
+ * @brief Build CRC-16/CCITT table, the CRC of every byte value.
+ */
+static constexpr std::array<uint16_t, 256> makeCrc16Table()
+{
+    std::array<uint16_t, 256> table = {};
+    for (int i = 0; i < 256; ++i) {
+        uint16_t crc = static_cast<uint16_t>(i << 8);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = static_cast<uint16_t>(crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+static constexpr std::array<uint16_t, 256> CRC16_TABLE = makeCrc16Table(); ///< Generated at compile time.
+
+uint16_t crc16(const char *data, size_t size, uint16_t crc)
+{
+    for (size_t i = 0; i < size; ++i) {
+        crc = static_cast<uint16_t>((crc << 8) ^ CRC16_TABLE[((crc >> 8) ^ static_cast<uint8_t>(data[i])) & 0xFF]);
+    }
+    return crc;
+}
+
+bool appendCheckedFrame(std::string &out, std::string_view payload, uint8_t seq)
+{
+    if (payload.size() > 0xFF) {
+        return false;
+    }
+    size_t start = out.size();
+    out += CHECKED_FRAME_MARKER;
+    out += static_cast<char>(payload.size());
+    out += static_cast<char>(seq);
+    out.append(payload.data(), payload.size());
+    uint16_t crc = crc16(out.data() + start + 1, 2 + payload.size());
+    out += static_cast<char>(crc & 0xFF);
+    out += static_cast<char>(crc >> 8);
+    return true;
+}
+
+bool ParseFrameCheck(std::string_view response)
+{
+    std::string_view cursor(response);
+    KeyValueToken token;
+    while (nextKeyValueToken(cursor, token, '&')) {
+        if (equalsKey(token.Key, "check", false)) {
+            return equalsKey(token.Value, FRAME_CHECK_NAME, false);
+        }
+    }
+    return false;
+}
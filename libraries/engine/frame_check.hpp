@@ -0,0 +1,218 @@
+/**
+ * @file frame_check.hpp
+ * @brief CRC-checked framing of the update frames.
+ *
+ * Optional envelope of text and binary frames, negotiated by "?INIT&check=crc16":
+ * @code
+ * '#' length seq payload[length] crc_lo crc_hi
+ * @endcode
+ * The payload is one or more frames ("?id=8&Temperature=25" or "!..."), seq counts the
+ * envelopes modulo 256 and the CRC-16/CCITT-FALSE covers length, seq and payload.
+ * CHECKED_FRAME_MARKER is reserved in text frames, like BINARY_FRAME_MARKER.
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#ifndef FRAME_CHECK_HPP
+#define FRAME_CHECK_HPP
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "parser.hpp" ///< forEachWireFrame.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define CHECKED_FRAME_MARKER '#'    ///< Start of checked frame.
+#define CHECKED_FRAME_OVERHEAD 5    ///< Marker, length, seq and CRC bytes.
+#define FRAME_CHECK_NAME "crc16"    ///< Name of the check, as used in "?INIT&check=<name>".
+#define CHECKED_REORDER_WINDOW 16   ///< Envelopes at most this far behind the last one are late, farther ones restart the seq.
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @struct FrameCheckStats
+ * @brief Error counters of the checked framing, a snapshot of FrameChecker::stats().
+ */
+struct FrameCheckStats
+{
+    unsigned long Valid = 0;        ///< Envelopes passing the check.
+    unsigned long CrcErrors = 0;    ///< Envelopes with CRC mismatch (corrupted or false marker).
+    unsigned long Truncated = 0;    ///< Envelopes cut by the end of the batch.
+    unsigned long Lost = 0;         ///< Envelopes missing in the seq order.
+    unsigned long Duplicates = 0;   ///< Envelopes repeating the last seq (retransmit, replay), dropped.
+    unsigned long Reordered = 0;    ///< Envelopes behind the last seq, dropped as older than the applied one.
+    unsigned long SkippedBytes = 0; ///< Bytes outside of valid envelopes (blanks excluded).
+};
+
+/*********************
+ *      DECLARES
+ *********************/
+
+/**
+ * @brief Compute CRC-16/CCITT-FALSE (polynomial 0x1021), table-driven.
+ *
+ * @param data The data.
+ * @param size The data size.
+ * @param crc The initial value, or CRC of the preceding data.
+ * @return The CRC.
+ */
+uint16_t crc16(const char *data, size_t size, uint16_t crc = 0xFFFF);
+
+/**
+ * @brief Append checked frame of the payload.
+ *
+ * @param out The output, the frame is appended.
+ * @param payload The frames to check, at most 255 bytes.
+ * @param seq The envelope sequence number.
+ * @return true if appended, false if the payload is too long.
+ */
+bool appendCheckedFrame(std::string &out, std::string_view payload, uint8_t seq);
+
+/**
+ * @brief Parse the frame check confirmed by the device in the init response.
+ *
+ * @param response The init response (e.g. "?0:ADC&1:TH&check=crc16").
+ * @return true if the device confirmed the checked framing.
+ */
+bool ParseFrameCheck(std::string_view response);
+
+/**
+ * @class FrameChecker
+ * @brief Validates checked frames of received batches and counts errors.
+ *
+ * A corrupted envelope costs only itself: the scan resumes at the next marker after the
+ * failed one, so the rest of the batch is kept. Frames outside of envelopes are ignored.
+ * Only forward seq gaps count as lost envelopes, a repeated or late envelope is dropped,
+ * so it neither looks like a loss nor overwrites newer values.
+ */
+class FrameChecker
+{
+public:
+    FrameChecker() : Stats(), LastSeq(-1) {}
+
+    /**
+     * @brief Validate the envelopes of the batch and dispatch their frames.
+     *
+     * @param batch The received batch.
+     * @param format The negotiated format of the frames in the envelopes.
+     * @param dispatch Callable invoked as for forEachWireFrame().
+     * @return The number of dispatched frames.
+     */
+    template <typename Dispatch>
+    size_t forEach(std::string_view batch, WireFormat format, Dispatch &&dispatch)
+    {
+        size_t count = 0;
+        while (!batch.empty()) {
+            size_t start = batch.find(CHECKED_FRAME_MARKER);
+            skip(batch.substr(0, start));
+            if (start == std::string_view::npos) {
+                break;
+            }
+            batch.remove_prefix(start);
+
+            size_t length = batch.size() > 1 ? static_cast<uint8_t>(batch[1]) : 0;
+            if (batch.size() < CHECKED_FRAME_OVERHEAD + length) {
+                ++Stats.Truncated;
+                ++Stats.SkippedBytes;
+                batch.remove_prefix(1); // Resume at the next marker.
+                continue;
+            }
+            const char *tail = batch.data() + 3 + length;
+            uint16_t crc = static_cast<uint16_t>(static_cast<uint8_t>(tail[0]) | (static_cast<uint8_t>(tail[1]) << 8));
+            if (crc16(batch.data() + 1, 2 + length) != crc) {
+                ++Stats.CrcErrors;
+                ++Stats.SkippedBytes;
+                batch.remove_prefix(1); // Resume at the next marker.
+                continue;
+            }
+
+            ++Stats.Valid;
+            if (accept(static_cast<uint8_t>(batch[2]))) {
+                count += forEachWireFrame(batch.substr(3, length), format, dispatch);
+            }
+            batch.remove_prefix(CHECKED_FRAME_OVERHEAD + length);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Get error counters, safe while another thread validates batches.
+     */
+    FrameCheckStats stats() const
+    {
+        FrameCheckStats stats;
+        stats.Valid = Stats.Valid;
+        stats.CrcErrors = Stats.CrcErrors;
+        stats.Truncated = Stats.Truncated;
+        stats.Lost = Stats.Lost;
+        stats.Duplicates = Stats.Duplicates;
+        stats.Reordered = Stats.Reordered;
+        stats.SkippedBytes = Stats.SkippedBytes;
+        return stats;
+    }
+
+    /**
+     * @brief Forget the last seq, e.g. after the device restarted.
+     */
+    void reset() { LastSeq = -1; }
+
+private:
+    /**
+     * @brief Counters of FrameCheckStats, written by the communication task in threaded mode.
+     */
+    struct Counters
+    {
+        std::atomic<unsigned long> Valid{0};
+        std::atomic<unsigned long> CrcErrors{0};
+        std::atomic<unsigned long> Truncated{0};
+        std::atomic<unsigned long> Lost{0};
+        std::atomic<unsigned long> Duplicates{0};
+        std::atomic<unsigned long> Reordered{0};
+        std::atomic<unsigned long> SkippedBytes{0};
+    };
+
+    Counters Stats;         ///< Error counters.
+    int LastSeq;            ///< Seq of the last valid envelope, -1 if none.
+
+    bool accept(uint8_t seq)
+    {
+        if (LastSeq >= 0) {
+            // Distance modulo 256: under 128 the envelope is ahead of the last one, above it behind.
+            uint8_t distance = static_cast<uint8_t>(seq - LastSeq);
+            if (distance == 0) {
+                ++Stats.Duplicates;
+                return false;
+            }
+            if (distance >= 256 - CHECKED_REORDER_WINDOW) {
+                ++Stats.Reordered;
+                return false;
+            }
+            if (distance < 128) {
+                Stats.Lost += distance - 1;
+            }
+            // Farther behind, the device restarted its seq.
+        }
+        LastSeq = seq;
+        return true;
+    }
+
+    void skip(std::string_view bytes)
+    {
+        for (char c : bytes) {
+            Stats.SkippedBytes += c != ' ' && c != '\r' && c != '\n';
+        }
+    }
+};
+
+#endif // FRAME_CHECK_HPP
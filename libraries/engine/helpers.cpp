@@ -4,34 +4,330 @@
 */
 
 #include "helpers.hpp"
+#include "config.hpp"
 
-std::string getValueFromKeyValueLikeString(std::string str, std::string key, char separator = '&') {
-    std::string value;
-    size_t pos = str.find(key);
-    if(pos != std::string::npos) {
-        pos += key.length() + 1;
-        size_t end = str.find(separator, pos);
-        value = str.substr(pos, end - pos);
+#ifdef ARDUINO_H
+    #include <Arduino.h>  ///< For millis
+    #include <esp_heap_caps.h> ///< For heap_caps_get_free_size
+#else
+    #include <chrono>     ///< For std::chrono::steady_clock
+    #include <thread>     ///< For std::this_thread::sleep_for
+    #ifdef __GLIBC__
+        #include <malloc.h>   ///< For mallinfo2
+    #endif
+#endif
+
+#include <charconv>  ///< For std::from_chars, std::to_chars
+#include <cmath>     ///< For std::isfinite
+#include <cstdio>    ///< For snprintf
+#include <limits>
+
+unsigned long getTimeMs() {
+#ifdef ARDUINO_H
+    return millis();
+#else
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count());
+#endif
+}
+
+unsigned long getTimeUs() {
+#ifdef ARDUINO_H
+    return micros();
+#else
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+#endif
+}
+
+void sleepMs(unsigned long ms) {
+#ifdef ARDUINO_H
+    delay(ms);
+#else
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+#endif
+}
+
+size_t getHeapUsed() {
+#ifdef ARDUINO_H
+    // Internal RAM and PSRAM alike, malloc() of LVGL places large objects into PSRAM.
+    return heap_caps_get_total_size(MALLOC_CAP_8BIT) - heap_caps_get_free_size(MALLOC_CAP_8BIT);
+#elif defined(__GLIBC__)
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+std::string_view trimView(std::string_view str) {
+    const char *blanks = " \t\r\n";
+    size_t begin = str.find_first_not_of(blanks);
+    if(begin == std::string_view::npos) {
+        return std::string_view();
     }
+    size_t end = str.find_last_not_of(blanks);
+    return str.substr(begin, end - begin + 1);
+}
 
-    return value;
+bool nextKeyValueToken(std::string_view &cursor, KeyValueToken &token, char separator) {
+    while(!cursor.empty()) {
+        size_t end = cursor.find(separator);
+        std::string_view field = cursor.substr(0, end);
+        cursor.remove_prefix(end == std::string_view::npos ? cursor.size() : end + 1);
+
+        field = trimView(field);
+        if(field.empty()) {
+            continue;
+        }
+
+        size_t eq = field.find('=');
+        if(eq == std::string_view::npos) {
+            token.Key = field;
+            token.Value = std::string_view();
+        }
+        else {
+            token.Key = trimView(field.substr(0, eq));
+            token.Value = trimView(field.substr(eq + 1));
+        }
+        return true;
+    }
+
+    return false;
+}
+
+bool equalsKey(std::string_view a, std::string_view b, bool caseSensitive) {
+    if(caseSensitive || a.size() != b.size()) {
+        return a == b;
+    }
+
+    for(size_t i = 0; i < a.size(); ++i) {
+        if(foldCase(a[i]) != foldCase(b[i])) {
+            return false;
+        }
+    }
+    return true;
 }
 
-std::vector<std::string> splitString(std::string str, char separator) {
-    std::vector<std::string> result;
-    if (str.empty()) {
-        return result;
+/**
+ * @brief Exact powers of ten representable by double.
+ */
+static const double POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+ParseStatus parseNumber(std::string_view str, int &value) {
+    if(str.empty()) {
+        return ParseStatus::EMPTY;
+    }
+
+    const char *begin = str.data();
+    const char *end = str.data() + str.size();
+    if(*begin == '+' && str.size() > 1 && begin[1] != '-') {
+        ++begin;
+    }
+
+    int result = 0;
+    std::from_chars_result parsed = std::from_chars(begin, end, result);
+    if(parsed.ec == std::errc::result_out_of_range) {
+        return ParseStatus::OUT_OF_RANGE;
+    }
+    if(parsed.ec != std::errc() || parsed.ptr != end) {
+        return ParseStatus::INVALID_FORMAT;
+    }
+
+    value = result;
+    return ParseStatus::OK;
+}
+
+ParseStatus parseNumber(std::string_view str, double &value) {
+    if(str.empty()) {
+        return ParseStatus::EMPTY;
     }
 
     size_t pos = 0;
-    size_t end = 0;
-    while((end = str.find(separator, pos)) != std::string::npos) {
-        result.push_back(str.substr(pos, end - pos));
-        pos = end + 1;
+    bool negative = false;
+    if(str[pos] == '+' || str[pos] == '-') {
+        negative = str[pos] == '-';
+        ++pos;
+    }
+
+    // Up to 19 significant digits are kept exactly, the rest only moves the exponent.
+    uint64_t mantissa = 0;
+    int significant = 0;
+    int exponent = 0;
+    int digits = 0;
+    for(; pos < str.size() && str[pos] >= '0' && str[pos] <= '9'; ++pos, ++digits) {
+        if(significant < 19) {
+            mantissa = mantissa * 10 + (str[pos] - '0');
+            significant += mantissa != 0;
+        }
+        else {
+            ++exponent;
+        }
+    }
+    if(pos < str.size() && str[pos] == '.') {
+        for(++pos; pos < str.size() && str[pos] >= '0' && str[pos] <= '9'; ++pos, ++digits) {
+            if(significant < 19) {
+                mantissa = mantissa * 10 + (str[pos] - '0');
+                significant += mantissa != 0;
+                --exponent;
+            }
+        }
+    }
+    if(digits == 0) {
+        return ParseStatus::INVALID_FORMAT;
+    }
+
+    if(pos < str.size() && (str[pos] == 'e' || str[pos] == 'E')) {
+        int exponentSign = 1;
+        int exponentValue = 0;
+        ++pos;
+        if(pos < str.size() && (str[pos] == '+' || str[pos] == '-')) {
+            exponentSign = str[pos] == '-' ? -1 : 1;
+            ++pos;
+        }
+        if(pos == str.size()) {
+            return ParseStatus::INVALID_FORMAT;
+        }
+        for(; pos < str.size() && str[pos] >= '0' && str[pos] <= '9'; ++pos) {
+            if(exponentValue < 10000) {
+                exponentValue = exponentValue * 10 + (str[pos] - '0');
+            }
+        }
+        exponent += exponentSign * exponentValue;
+    }
+    if(pos != str.size()) {
+        return ParseStatus::INVALID_FORMAT;
+    }
+
+    double result = static_cast<double>(mantissa);
+    if(mantissa != 0) {
+        while(exponent > 22) {
+            result *= 1e22;
+            exponent -= 22;
+        }
+        while(exponent < -22) {
+            result /= 1e22;
+            exponent += 22;
+        }
+        result = exponent < 0 ? result / POWERS_OF_TEN[-exponent] : result * POWERS_OF_TEN[exponent];
+        if(!std::isfinite(result) || result == 0.0) {
+            return ParseStatus::OUT_OF_RANGE;
+        }
+    }
+
+    value = negative ? -result : result;
+    return ParseStatus::OK;
+}
+
+ParseStatus parseNumber(std::string_view str, float &value) {
+    double result = 0.0;
+    ParseStatus status = parseNumber(str, result);
+    if(status != ParseStatus::OK) {
+        return status;
+    }
+    if(std::fabs(result) > std::numeric_limits<float>::max()) {
+        return ParseStatus::OUT_OF_RANGE;
+    }
+
+    value = static_cast<float>(result);
+    return ParseStatus::OK;
+}
+
+size_t formatNumber(char *buffer, size_t size, int value) {
+    if(buffer == nullptr || size == 0) {
+        return 0;
+    }
+
+    std::to_chars_result formatted = std::to_chars(buffer, buffer + size - 1, value);
+    if(formatted.ec != std::errc()) {
+        buffer[0] = '\0';
+        return 0;
+    }
+
+    *formatted.ptr = '\0';
+    return formatted.ptr - buffer;
+}
+
+size_t formatNumber(char *buffer, size_t size, double value, int decimals) {
+    if(buffer == nullptr || size == 0) {
+        return 0;
+    }
+
+    const bool automatic = decimals < 0;
+    double magnitude = std::fabs(value);
+    if(automatic) {
+        // 6 significant digits, as "%g"
+        int integerDigits = 1;
+        for(double limit = 10.0; magnitude >= limit && integerDigits < 6; limit *= 10.0) {
+            ++integerDigits;
+        }
+        decimals = 6 - integerDigits;
+        for(double limit = 0.1; magnitude != 0.0 && magnitude < limit && decimals < 9; limit /= 10.0) {
+            ++decimals;
+        }
+    }
+    if(decimals > 9) {
+        decimals = 9;
+    }
+
+    // Out of the fixed-point range (the scaled value must fit 63 bits), fall back to printf.
+    const double scale = POWERS_OF_TEN[decimals];
+    if(!std::isfinite(value) || magnitude * scale >= 9.2e18 || (automatic && (magnitude >= 1e15 || (magnitude != 0.0 && magnitude < 1e-4)))) {
+        int length = automatic ? snprintf(buffer, size, "%g", value) : snprintf(buffer, size, "%.*f", decimals, value);
+        if(length < 0 || static_cast<size_t>(length) >= size) {
+            buffer[0] = '\0';
+            return 0;
+        }
+        return length;
+    }
+
+    uint64_t scaled = static_cast<uint64_t>(magnitude * scale + 0.5);
+    uint64_t integer = scaled / static_cast<uint64_t>(scale);
+    uint64_t fraction = scaled % static_cast<uint64_t>(scale);
+
+    if(automatic) {
+        while(decimals > 0 && fraction % 10 == 0) {
+            fraction /= 10;
+            --decimals;
+        }
     }
-    result.push_back(str.substr(pos));
 
-    return result;
+    char *out = buffer;
+    char *last = buffer + size - 1;
+    if(value < 0 && scaled != 0) {
+        if(out == last) {
+            buffer[0] = '\0';
+            return 0;
+        }
+        *out++ = '-';
+    }
+
+    std::to_chars_result formatted = std::to_chars(out, last, integer);
+    if(formatted.ec != std::errc()) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    out = formatted.ptr;
+
+    if(decimals > 0) {
+        if(last - out < decimals + 1) {
+            buffer[0] = '\0';
+            return 0;
+        }
+        *out++ = '.';
+        for(int i = decimals - 1; i >= 0; --i) {
+            out[i] = static_cast<char>('0' + fraction % 10);
+            fraction /= 10;
+        }
+        out += decimals;
+    }
+
+    *out = '\0';
+    return out - buffer;
 }
 
 template <typename T>
@@ -43,53 +339,37 @@ T convertStringToType(const std::string &str) {
 // Specialization for int
 template <>
 int convertStringToType<int>(const std::string &str) {
-    if (str.empty()) {
-        return int(); // Return default-constructed int (0)
-    }
-
-    try
-    {
-        return std::stoi(str);
-    }
-    catch(const std::exception& e)
-    {
+    int value = int(); // Default-constructed int (0) for empty string
+    ParseStatus status = parseNumber(str, value);
+    if(status != ParseStatus::OK && status != ParseStatus::EMPTY) {
         throw InvalidDataTypeException("convertStringToType<int>", str + " is non-int format string!");
     }
-     
+
+    return value;
 }
 
 // Specialization for double
 template <>
 double convertStringToType<double>(const std::string &str) {
-    if (str.empty()) {
-        return double(); // Return default double (0.0)
-    }
-
-    try
-    {
-        return std::stod(str);
-    }
-    catch(const std::exception& e)
-    {
+    double value = double(); // Default double (0.0) for empty string
+    ParseStatus status = parseNumber(str, value);
+    if(status != ParseStatus::OK && status != ParseStatus::EMPTY) {
         throw InvalidDataTypeException("convertStringToType<double>", str + " is non-double format string!");
     }
+
+    return value;
 }
 
 // Specialization for float
 template <>
 float convertStringToType<float>(const std::string &str) {
-    if (str.empty()) {
-        return float(); // Return default float (0.0f)
-    }
-
-    try
-    {
-        return std::stof(str);
-    }
-    catch(const std::exception& e)
-    {
+    float value = float(); // Default float (0.0f) for empty string
+    ParseStatus status = parseNumber(str, value);
+    if(status != ParseStatus::OK && status != ParseStatus::EMPTY) {
         throw InvalidDataTypeException("convertStringToType<float>", str + " is non-float format string!");
     }
+
+    return value;
 }
 
 // Specialization for std::string
@@ -11,7 +11,10 @@
  *********************/
 #include "exceptions.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
+#include <cstdint>
+#include <cstddef>
 #include <type_traits>      ///< For is_same
 #include <algorithm>      ///< For std::replace
 
@@ -19,32 +22,228 @@
  *      TYPEDEFS
  **********************/
 
+/**
+ * @brief Single key/value field of a key-value like string.
+ * 
+ * Both members are views into the tokenized string, they are valid only
+ * as long as the underlying buffer is alive and unchanged.
+ */
+struct KeyValueToken
+{
+  std::string_view Key;   ///< Field key.
+  std::string_view Value; ///< Field value (empty if the field has no '=').
+};
+
+/**
+ * @brief Fold ASCII letter to lower case.
+ */
+constexpr char foldCase(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/**
+ * @brief Compute hash of a key.
+ * 
+ * FNV-1a over the key bytes with a final avalanche step, so the low bits used for
+ * slot selection depend on the whole key. Evaluable at compile time, which is used
+ * by the sensor field schemas to build their lookup tables.
+ * 
+ * @param key The key to hash.
+ * @param seed The hash seed.
+ * @param caseSensitive Flag if the key is hashed as is, otherwise ASCII letters are folded,
+ *                      so keys differing only in case have the same hash.
+ * @return The hash of the key.
+ */
+constexpr uint32_t hashKey(std::string_view key, uint32_t seed = 0, bool caseSensitive = true)
+{
+    uint32_t hash = 2166136261u ^ seed;
+    for(char c : key) {
+        hash ^= static_cast<uint8_t>(caseSensitive ? c : foldCase(c));
+        hash *= 16777619u;
+    }
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+/**
+ * @enum ParseStatus
+ * @brief Result of the non-throwing number parsing.
+ *
+ * - OK: Number parsed.
+ * - EMPTY: Input string is empty.
+ * - INVALID_FORMAT: Input string is not a number of requested type.
+ * - OUT_OF_RANGE: Number does not fit into requested type.
+ */
+enum class ParseStatus {
+    OK,
+    EMPTY,
+    INVALID_FORMAT,
+    OUT_OF_RANGE
+};
 
 /*********************
  *      DECLARES
  *********************/
 
 /**
- * @brief Get value from update string.
+ * @brief Trim whitespace and line endings from both ends of the view.
+ * 
+ * @param str The view to trim.
+ * @return The trimmed view (empty if the view contains only whitespace).
+ */
+std::string_view trimView(std::string_view str);
+
+/**
+ * @brief Read next key/value token from key-value like string.
+ * 
+ * Consumes one field from the front of the cursor, so walking a whole frame
+ * with repeated calls is a single pass without any allocation. Surrounding
+ * whitespace (including line endings) is trimmed and empty fields are skipped.
+ * 
+ * @param cursor The unread rest of the string, advanced past the returned field.
+ * @param token The token to fill.
+ * @param separator The field separator.
+ * @return true if a token was read, false if the string is exhausted.
+ */
+bool nextKeyValueToken(std::string_view &cursor, KeyValueToken &token, char separator = '&');
+
+/**
+ * @brief Compare two keys.
+ * 
+ * @param a The first key.
+ * @param b The second key.
+ * @param caseSensitive Flag if the keys are compared case-sensitive, otherwise ASCII letters are folded.
+ * @return true if the keys are equal, false otherwise.
+ */
+bool equalsKey(std::string_view a, std::string_view b, bool caseSensitive = true);
+
+/**
+ * @brief Get monotonic time in milliseconds.
+ * 
+ * millis() on Arduino, steady clock on host. The value wraps around, compare
+ * two times by their unsigned difference only.
+ * 
+ * @return The time in milliseconds.
+ */
+unsigned long getTimeMs();
+
+/**
+ * @brief Get monotonic time in microseconds.
+ * 
+ * micros() on Arduino, steady clock on host. The value wraps around, compare
+ * two times by their unsigned difference only.
+ * 
+ * @return The time in microseconds.
+ */
+unsigned long getTimeUs();
+
+/**
+ * @brief Let other tasks run for the given time.
+ * 
+ * delay() on Arduino, sleep of the calling thread on host.
+ * 
+ * @param ms The time in milliseconds.
+ */
+void sleepMs(unsigned long ms);
+
+/**
+ * @brief Get heap in use, LVGL objects included (LV_MEM_CUSTOM allocates them by malloc).
+ * 
+ * Byte-addressable heap of ESP on Arduino (internal RAM and PSRAM), the malloc arena of
+ * glibc on host, 0 where unknown. Allocations of all tasks are counted.
+ * 
+ * @return The used heap in bytes.
+ */
+size_t getHeapUsed();
+
+/**
+ * @brief Read 32-bit little-endian word, independent of the platform byte order.
+ * 
+ * @param data The first byte of the word.
+ * @return The word.
+ */
+inline uint32_t readUint32LE(const char *data)
+{
+    const uint8_t *bytes = reinterpret_cast<const uint8_t*>(data);
+    return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+           (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+/**
+ * @brief Write 32-bit little-endian word, independent of the platform byte order.
+ * 
+ * @param data The first byte of the word.
+ * @param value The word.
+ */
+inline void writeUint32LE(char *data, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i) {
+        data[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+/**
+ * @brief Parse integer number.
+ * 
+ * Locale independent and non-throwing. The whole string must be a decimal integer
+ * with optional sign, otherwise the value is left unchanged.
+ * 
+ * @param str The string to parse.
+ * @param value The parsed value.
+ * @return The parse status.
+ */
+ParseStatus parseNumber(std::string_view str, int &value);
+
+/**
+ * @brief Parse floating point number.
+ * 
+ * Locale independent and non-throwing. The whole string must be a decimal number
+ * with optional sign, fraction and exponent, otherwise the value is left unchanged.
+ * 
+ * @param str The string to parse.
+ * @param value The parsed value.
+ * @return The parse status.
+ */
+ParseStatus parseNumber(std::string_view str, double &value);
+
+/**
+ * @brief Parse floating point number.
+ * 
+ * @see parseNumber(std::string_view, double&)
+ */
+ParseStatus parseNumber(std::string_view str, float &value);
+
+/**
+ * @brief Format integer number.
  * 
- * This function extracts the value of a given key from an update string.
+ * Locale independent and non-throwing, the output is null terminated.
  * 
- * @param str The input string.
- * @param key The key to search for.
- * @return The value corresponding to the key, if exist.
+ * @param buffer The output buffer.
+ * @param size The output buffer size.
+ * @param value The value to format.
+ * @return The length of formatted text, 0 if the buffer is too small.
  */
-std::string getValueFromKeyValueLikeString(std::string str, std::string key, char separator);
+size_t formatNumber(char *buffer, size_t size, int value);
 
 /**
- * @brief Split string by separator.
+ * @brief Format floating point number.
  * 
- * This function splits a string into a vector of strings using a specified separator.
+ * Locale independent and non-throwing, the output is null terminated. With automatic
+ * precision the number is printed with 6 significant digits and no trailing zeros,
+ * like the printf "%g" conversion for the usual sensor ranges.
  * 
- * @param str The input string.
- * @param separator The separator character.
- * @return A vector of strings.
+ * @param buffer The output buffer.
+ * @param size The output buffer size.
+ * @param value The value to format.
+ * @param decimals The number of decimal places, negative for automatic precision.
+ * @return The length of formatted text, 0 if the buffer is too small.
  */
-std::vector<std::string> splitString(std::string str, char separator);
+size_t formatNumber(char *buffer, size_t size, double value, int decimals = -1);
 
 /**
  * @brief Convert string to type.
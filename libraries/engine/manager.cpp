@@ -18,6 +18,13 @@
 #include "parser.hpp"
 #include "helpers.hpp"
 #include "base_sensor.hpp"
+#include "config.hpp"
+
+#ifdef ARDUINO_H
+    #include <Arduino.h>  ///< For xTaskCreatePinnedToCore
+#else
+    #include <thread>     ///< For std::thread
+#endif
 
 SensorManager& SensorManager::getInstance() {
     static SensorManager instance;
@@ -25,79 +32,201 @@ SensorManager& SensorManager::getInstance() {
 }
 
 SensorManager::SensorManager()
- : Sensors(), currentIndex(0)
+ : Sensors(), Widgets(), WidgetHeap(0), Leaving(nullptr), Buses{new BusShard(getMessenger())}, currentIndex(0),
+   CaseSensitive(CASE_SENSITIVE_SYNC), Tasks(), Running(false), Paused(false)
 {
 }
 
 SensorManager::~SensorManager() {
+    stopThreaded();
     for (auto* s : Sensors) delete s;
+    for (auto* bus : Buses) delete bus;
 }
 
 void SensorManager::hideAllExceptFirst() {
-    for (auto* s : Sensors) {
-        constructSensor(s);
-    }
-    for (size_t i = 1; i < Sensors.size(); ++i) {
-        Sensors[i]->hide();
-    }
-    if (!Sensors.empty()) {
-        Sensors[0]->show();
-        currentIndex = 0;
-    }
+    currentIndex = 0;
+    reconstruct();
 }
 
 void SensorManager::nextSensor() {
     if (Sensors.empty()) {
         return;
     }
-    Sensors[currentIndex]->hide();
+    hideSensor(Sensors[currentIndex]);
     currentIndex = (currentIndex + 1) % Sensors.size();
-    Sensors[currentIndex]->show();
+    showSensor(Sensors[currentIndex]);
 }
 
 void SensorManager::prevSensor() {
     if (Sensors.empty()) {
         return;
     }
-    Sensors[currentIndex]->hide();
+    hideSensor(Sensors[currentIndex]);
     currentIndex = (currentIndex + Sensors.size() - 1) % Sensors.size();
-    Sensors[currentIndex]->show();
+    showSensor(Sensors[currentIndex]);
 }
 
-void SensorManager::init(bool fromRequest) {
-    initMessenger();
-    if (!fromRequest) {
-        logMessage("Initializing manager via fixed sensors list...\n");
-        createSensorList(Sensors);
-        return;
+bool SensorManager::isShown(const BaseSensor* sensor) const {
+    for (auto* shown : Shown) {
+        if (shown == sensor) return true;
     }
-    logMessage("Initializing manager via request...\n");
-    std::string request = "?INIT";
-    sendMessage(request);
-    std::string response = receiveMessage();
-    if (response.empty() || response[0] != '?') {
-        logMessage("Invalid sensor list format!\n");
-        init(false);
-        return;
+    return false;
+}
+
+bool SensorManager::isConstructed(const BaseSensor* sensor) const {
+    for (const Widget& widget : Widgets) {
+        if (widget.Sensor == sensor) return true;
     }
-    response.erase(0, 1);
-    createSensorList(Sensors, response);
+    return false;
 }
 
-BaseSensor* SensorManager::getSensor(std::string uid) {
-    for (auto* sensor : Sensors) {
-        if (sensor->UID == uid) return sensor;
+void SensorManager::showSensor(BaseSensor* sensor) {
+    if (!isShown(sensor)) Shown.push_back(sensor);
+    // The widget moves to the most recently shown end, or is constructed there.
+    Widget widget{sensor, 0};
+    bool constructed = false;
+    for (size_t i = 0; i < Widgets.size(); ++i) {
+        if (Widgets[i].Sensor == sensor) {
+            widget = Widgets[i];
+            Widgets.erase(Widgets.begin() + i);
+            constructed = true;
+            break;
+        }
+    }
+    if (!constructed) {
+        // The heap is shared, so the communication tasks wait between their resyncs while it is measured.
+        bool threaded = pauseThreaded();
+        size_t before = getHeapUsed();
+        constructSensor(sensor);
+        size_t after = getHeapUsed();
+        resumeThreaded(threaded);
+        widget.Bytes = after > before ? after - before : 0;
+        WidgetHeap += widget.Bytes;
+        sensor->requestRedraw(); // The new widget shows no values yet.
+    }
+    Widgets.push_back(widget);
+    sensor->show();
+    drawSensor(sensor); // Values received while hidden, the widget is shown up to date.
+    trimWidgets();
+}
+
+void SensorManager::hideSensor(BaseSensor* sensor) {
+    for (size_t i = 0; i < Shown.size(); ++i) {
+        if (Shown[i] == sensor) {
+            Shown[i] = Shown.back();
+            Shown.pop_back();
+            break;
+        }
+    }
+    if (isConstructed(sensor)) sensor->hide();
+    Leaving = sensor;
+}
+
+void SensorManager::destructWidget(size_t i, bool deferred) {
+    destructSensor(Widgets[i].Sensor, deferred);
+    WidgetHeap -= Widgets[i].Bytes;
+    Widgets.erase(Widgets.begin() + i);
+}
+
+void SensorManager::trimWidgets() {
+    // Least recently shown first, visible widgets are kept even over the budget.
+    for (size_t i = 0; WIDGET_HEAP_BUDGET > 0 && WidgetHeap > WIDGET_HEAP_BUDGET && i < Widgets.size();) {
+        if (isShown(Widgets[i].Sensor)) {
+            ++i;
+        } else {
+            // Deleted at once, so the next construction finds the heap freed; only the widget
+            // just left may still be handling the click of its navigation button.
+            destructWidget(i, Widgets[i].Sensor == Leaving);
+        }
+    }
+}
+
+void SensorManager::setTransport(Transport* transport) {
+    bool threaded = pauseThreaded();
+    Buses[0]->setTransport(transport);
+    resumeThreaded(threaded);
+}
+
+size_t SensorManager::addBus(Transport* transport) {
+    // The new bus needs its own task, so the tasks are started again.
+    bool threaded = isThreaded();
+    stopThreaded();
+    BusShard* bus = new BusShard(transport);
+    bus->setCaseSensitive(CaseSensitive);
+    Buses.push_back(bus);
+    if (threaded) startThreaded();
+    return Buses.size() - 1;
+}
+
+void SensorManager::init(bool fromRequest) {
+    bool threaded = pauseThreaded();
+    for (size_t i = 0; i < Buses.size(); ++i) {
+        BusShard* bus = Buses[i];
+        if (i == 0 && !fromRequest) {
+            logMessage("Initializing manager via fixed sensors list...\n");
+            bus->init(false);
+        }
+        else {
+            logMessage("Initializing bus %d via request...\n", static_cast<int>(i));
+            if (!bus->init(true)) {
+                logMessage("Invalid sensor list format!\n");
+                if (i == 0) bus->init(false);
+            }
+        }
+        for (auto* sensor : bus->getSensors()) {
+            Sensors.push_back(sensor);
+            Index.insert(sensor->UID, sensor);
+        }
     }
-    return nullptr;
+    resumeThreaded(threaded);
+}
+
+BaseSensor* SensorManager::getSensor(std::string_view uid) {
+    return Index.find(uid);
 }
 
-void SensorManager::addSensor(BaseSensor* sensor) {
-    if (sensor) Sensors.push_back(sensor);
+BaseSensor* SensorManager::getSensor(uint32_t id) {
+    return Index.find(id);
+}
+
+void SensorManager::addSensor(BaseSensor* sensor, size_t bus) {
+    if (!sensor || bus >= Buses.size()) return;
+    bool threaded = pauseThreaded();
+    Buses[bus]->addSensor(sensor);
+    resumeThreaded(threaded);
+    Sensors.push_back(sensor);
+    Index.insert(sensor->UID, sensor);
 }
 
 void SensorManager::sync(std::string id) {
-    BaseSensor* sensor = getSensor(id);
-    if (sensor) syncSensor(sensor);
+    bool threaded = pauseThreaded();
+    // The bus of the sensor requests it, the reply is split and checked as negotiated by its ?INIT.
+    for (auto* bus : Buses) {
+        BaseSensor* sensor = bus->getSensor(id);
+        if (!sensor) continue;
+        try {
+            bus->sync(sensor);
+        } catch (const Exception &ex) {
+            ex.print();
+            sensor->setError(new Exception(ex));
+        }
+        break;
+    }
+    resumeThreaded(threaded);
+}
+
+void SensorManager::syncAll() {
+    // All buses are synchronized side by side, so the slowest one sets the total time
+    // instead of adding to it.
+    bool threaded = pauseThreaded();
+    for (auto* bus : Buses) bus->beginSyncAll();
+    for (;;) {
+        bool busy = false;
+        for (auto* bus : Buses) busy |= bus->syncStep();
+        if (!busy) break;
+        sleepMs(1);
+    }
+    resumeThreaded(threaded);
 }
 
 void SensorManager::print(std::string uid) {
@@ -110,28 +239,237 @@ void SensorManager::print() {
 }
 
 void SensorManager::redraw() {
-    for (auto* sensor : Sensors) drawSensor(sensor);
+    drain();
+    // Hidden sensors keep their redraw flag, they are drawn once shown again.
+    for (auto* sensor : Shown) drawSensor(sensor);
 }
 
 void SensorManager::reconstruct() {
-    for (auto* sensor : Sensors) constructSensor(sensor);
+    // Only the current sensor is constructed, the others on their first show, so the boot
+    // time and heap do not grow with the sensor count.
+    while (!Widgets.empty()) destructWidget(Widgets.size() - 1, true);
+    Shown.clear();
+    if (currentIndex < Sensors.size()) showSensor(Sensors[currentIndex]);
 }
 
-void SensorManager::resync() {
-    std::string request = "?UPDATE";
-    sendMessage(request);
-    std::string response = receiveMessage();
-    auto responses = splitString(response, '?');
-    for (auto& resp : responses) {
-        auto metadata = ParseMetadata(resp, CASE_SENSITIVE_SYNC);
-        if (CheckMetadata(&metadata)) {
-            BaseSensor* sensor = getSensor(metadata.UID);
-            if (sensor) updateSensor(sensor, metadata.Data);
+void SensorManager::setFrameCheck(bool enabled) {
+    bool threaded = pauseThreaded();
+    for (auto* bus : Buses) bus->setFrameCheck(enabled);
+    resumeThreaded(threaded);
+}
+
+bool SensorManager::isFrameChecked() const {
+    for (auto* bus : Buses) {
+        if (bus->isFrameChecked()) return true;
+    }
+    return false;
+}
+
+FrameCheckStats SensorManager::getFrameCheckStats() const {
+    FrameCheckStats total;
+    for (auto* bus : Buses) {
+        FrameCheckStats stats = bus->getFrameCheckStats();
+        total.Valid += stats.Valid;
+        total.CrcErrors += stats.CrcErrors;
+        total.Truncated += stats.Truncated;
+        total.Lost += stats.Lost;
+        total.Duplicates += stats.Duplicates;
+        total.Reordered += stats.Reordered;
+        total.SkippedBytes += stats.SkippedBytes;
+    }
+    return total;
+}
+
+void SensorManager::setCoalescing(bool enabled) {
+    bool threaded = pauseThreaded();
+    for (auto* bus : Buses) bus->setCoalescing(enabled);
+    resumeThreaded(threaded);
+}
+
+unsigned long SensorManager::getCoalescedFrames() const {
+    unsigned long total = 0;
+    for (auto* bus : Buses) total += bus->getCoalescedFrames();
+    return total;
+}
+
+unsigned long SensorManager::getDroppedFrames() const {
+    unsigned long total = 0;
+    for (auto* bus : Buses) total += bus->getDroppedFrames();
+    return total;
+}
+
+unsigned long SensorManager::getDroppedUpdates() const {
+    unsigned long total = 0;
+    for (auto* bus : Buses) total += bus->getDroppedUpdates();
+    return total;
+}
+
+void SensorManager::subscribe() {
+    bool threaded = pauseThreaded();
+    for (auto* bus : Buses) bus->subscribe();
+    resumeThreaded(threaded);
+}
+
+void SensorManager::subscribe(std::string_view uid, unsigned long periodMs) {
+    for (auto* bus : Buses) {
+        BaseSensor* sensor = bus->getSensor(uid);
+        if (sensor) {
+            bool threaded = pauseThreaded();
+            bus->subscribe(sensor, periodMs);
+            resumeThreaded(threaded);
+            return;
         }
     }
 }
 
+void SensorManager::setSamplePeriod(std::string_view uid, unsigned long periodMs) {
+    for (auto* bus : Buses) {
+        BaseSensor* sensor = bus->getSensor(uid);
+        if (sensor) {
+            bool threaded = pauseThreaded();
+            bus->setSamplePeriod(sensor, periodMs);
+            resumeThreaded(threaded);
+            return;
+        }
+    }
+}
+
+void SensorManager::unsubscribe() {
+    bool threaded = pauseThreaded();
+    for (auto* bus : Buses) bus->unsubscribe();
+    resumeThreaded(threaded);
+}
+
+bool SensorManager::isSubscribed() const {
+    for (auto* bus : Buses) {
+        if (bus->isSubscribed()) return true;
+    }
+    return false;
+}
+
+void SensorManager::resync() {
+    if (isThreaded()) return; // The communication tasks resync.
+    // Each bus ingests from its own receive queue, a slow bus never holds the others.
+    for (auto* bus : Buses) bus->resync();
+}
+
+void SensorManager::setCaseSensitive(bool caseSensitive) {
+    bool threaded = pauseThreaded();
+    CaseSensitive = caseSensitive;
+    for (auto* bus : Buses) bus->setCaseSensitive(caseSensitive);
+    resumeThreaded(threaded);
+}
+
 void SensorManager::erase() {
+    stopThreaded();
+    while (!Widgets.empty()) destructWidget(Widgets.size() - 1, true);
     for (auto* sensor : Sensors) delete sensor;
     Sensors.clear();
-}
\ No newline at end of file
+    Shown.clear();
+    Index.clear();
+    for (auto* bus : Buses) bus->clear();
+    currentIndex = 0;
+    Leaving = nullptr;
+}
+
+bool SensorManager::startThreaded() {
+    if (isThreaded()) return true;
+    for (auto* sensor : Sensors) {
+        if (sensor->hasStringValues()) {
+            logMessage("Sensor %s has STRING values, staying single-threaded.\n", sensor->UID.c_str());
+            return false;
+        }
+    }
+    Running = true;
+    Paused = false;
+    for (auto* bus : Buses) {
+        CommTask* task = new CommTask();
+        task->Manager = this;
+        task->Bus = bus;
+        task->Idle = true;
+        task->Finished = false;
+        bus->setUpdateQueue(&task->Updates);
+        Tasks.push_back(task);
+#ifdef ARDUINO_H
+        char name[configMAX_TASK_NAME_LEN];
+        snprintf(name, sizeof(name), "comm%u", static_cast<unsigned>(Tasks.size() - 1));
+        if (xTaskCreatePinnedToCore(commTask, name, COMM_TASK_STACK, task, COMM_TASK_PRIORITY, nullptr,
+                                    COMM_TASK_CORE) != pdPASS) {
+            logMessage("Communication task of bus %d not created, staying single-threaded.\n",
+                       static_cast<int>(Tasks.size() - 1));
+            task->Finished = true;
+            stopThreaded();
+            return false;
+        }
+#else
+        std::thread(commTask, task).detach();
+#endif
+    }
+    return true;
+}
+
+void SensorManager::stopThreaded() {
+    if (!isThreaded()) return;
+    Running = false;
+    for (auto* task : Tasks) {
+        while (!task->Finished) sleepMs(1);
+    }
+    drain();
+    for (auto* task : Tasks) {
+        task->Bus->setUpdateQueue(nullptr);
+        delete task;
+    }
+    Tasks.clear();
+}
+
+bool SensorManager::pauseThreaded() {
+    // The tasks are not stopped, they only wait between two resyncs, so a pause costs at most
+    // the resync in progress. Meanwhile the buses apply received values in place, as unthreaded.
+    if (!isThreaded() || Paused) return false;
+    Paused = true;
+    for (auto* task : Tasks) {
+        while (!task->Idle) sleepMs(1);
+    }
+    drain(); // Queued values are older than the ones applied in place.
+    for (auto* task : Tasks) task->Bus->setUpdateQueue(nullptr);
+    return true;
+}
+
+void SensorManager::resumeThreaded(bool paused) {
+    if (!paused) return;
+    for (auto* task : Tasks) task->Bus->setUpdateQueue(&task->Updates);
+    Paused = false;
+}
+
+size_t SensorManager::drain() {
+    // At most one queue of updates per bus, a fast producer never keeps the UI thread here.
+    size_t count = 0;
+    SensorUpdate update;
+    for (auto* task : Tasks) {
+        for (size_t n = 0; n < UPDATE_QUEUE_CAP && task->Updates.pop(update); ++n) {
+            update.Sensor->applyUpdate(update);
+            ++count;
+        }
+    }
+    return count;
+}
+
+void SensorManager::commTask(void* task) {
+    CommTask* self = static_cast<CommTask*>(task);
+    while (self->Manager->Running) {
+        // Idle is cleared before Paused is checked, so pauseThreaded() never sees a stale Idle.
+        self->Idle = false;
+        if (self->Manager->Paused) {
+            self->Idle = true;
+            sleepMs(1);
+            continue;
+        }
+        self->Bus->resync();
+        self->Idle = true;
+        sleepMs(COMM_CYCLE_MS);
+    }
+    self->Finished = true;
+#ifdef ARDUINO_H
+    vTaskDelete(nullptr);
+#endif
+}
@@ -12,10 +12,20 @@
 #define MANAGER_HPP
 
 #include <vector>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
+
+#include "parser.hpp"
+#include "bus_shard.hpp"
+#include "frame_check.hpp"
+#include "sensor_index.hpp"
+#include "sensor_update.hpp"
 
 class BaseSensor;
+class Transport;
 
 class SensorManager {
 public:
@@ -31,24 +41,118 @@ public:
     void nextSensor();
     void prevSensor();
 
+    // Visible sensors, redraw() draws only these, so its cost follows the screen, not the fleet
+    bool isShown(const BaseSensor* sensor) const;
+
+    // Widgets are constructed on first show, the least recently shown hidden ones are
+    // deleted once they take more than WIDGET_HEAP_BUDGET of heap
+    bool isConstructed(const BaseSensor* sensor) const;
+    size_t getWidgetHeap() const { return WidgetHeap; }
+
+    // The primary bus uses the fixed list or the ?INIT request, extra buses always the
+    // request (the fixed list describes the primary device)
     void init(bool fromRequest = false);
 
-    BaseSensor* getSensor(std::string uid);
-    void addSensor(BaseSensor* sensor);
+    // Lookup in the merged registry, the first sensor with the uid (uids may repeat across buses),
+    // numeric uids also by value (e.g. getSensor(8) for "8")
+    BaseSensor* getSensor(std::string_view uid);
+    BaseSensor* getSensor(uint32_t id);
+    void addSensor(BaseSensor* sensor, size_t bus = 0);
     void sync(std::string id);
+    void syncAll();
     void print(std::string uid);
     void print();
-    void redraw();
+    void redraw();   // Shown sensors only, updates of the communication task applied first
     void reconstruct();
-    void resync();
+    void resync();   // Due sensors only, call it every loop; nothing in threaded mode
     void erase();
 
+    // Case-insensitive key matching of received frames (all sensors)
+    void setCaseSensitive(bool caseSensitive);
+
+    // Format of the update frames of the primary bus, negotiated by init(true)
+    WireFormat getWireFormat() const { return Buses[0]->getWireFormat(); }
+
+    // Push mode: the device streams frames of each sensor at its SubscribePeriodMs and on
+    // change, resync() then only ingests them
+    void subscribe();
+    void subscribe(std::string_view uid, unsigned long periodMs);
+
+    // Poll mode: resync() requests each sensor at its SamplePeriodMs, due sensors of a bus in one frame
+    void setSamplePeriod(std::string_view uid, unsigned long periodMs);
+    void unsubscribe();
+    bool isSubscribed() const;
+
+    // CRC-checked framing, negotiated by init(true), and its error counters (all buses)
+    void setFrameCheck(bool enabled);
+    bool isFrameChecked() const;
+    FrameCheckStats getFrameCheckStats() const;
+
+    // Coalescing of frames received by one resync (latest value wins) and its counters
+    void setCoalescing(bool enabled);
+    unsigned long getCoalescedFrames() const;
+    unsigned long getDroppedFrames() const;
+
+    // Threaded mode: a communication task per bus (pinned to COMM_TASK_CORE on the board, a
+    // thread on host) resyncs its bus and queues the received values as typed updates, which
+    // redraw() applies. The UI thread alone touches the sensors, so a slow bus never delays a
+    // frame nor the other buses. Started after init(); the other calls touching the buses
+    // (sync, syncAll, subscribe, setSamplePeriod, ...) pause the tasks between two resyncs,
+    // addBus() stops them and starts them again with the new bus.
+    // Updates carry numbers only, so a sensor with STRING values keeps it single-threaded.
+    bool startThreaded();
+    void stopThreaded();
+    bool isThreaded() const { return !Tasks.empty(); }
+    size_t drain();  // Apply the queued updates, returns their number
+    unsigned long getDroppedUpdates() const; // Updates dropped on a full queue
+
+    // Link to the device of the primary bus, the platform default unless set before init()
+    void setTransport(Transport* transport);
+
+    // Extra buses, each synchronized by its own shard; added before init(), returns the bus index
+    size_t addBus(Transport* transport);
+    size_t getBusCount() const { return Buses.size(); }
+    BusShard& getBus(size_t bus) { return *Buses[bus]; }
+
 private:
     SensorManager();
     ~SensorManager();
 
-    std::vector<BaseSensor*> Sensors;
+    void showSensor(BaseSensor* sensor);
+    void hideSensor(BaseSensor* sensor);
+    void destructWidget(size_t i, bool deferred);
+    void trimWidgets();
+    bool pauseThreaded();             // Waits until the tasks are between resyncs and holds them there, returns if it paused them
+    void resumeThreaded(bool paused);
+    static void commTask(void* task);
+
+    // Communication task of one bus, the only writer of its queue
+    struct CommTask {
+        SensorManager* Manager;
+        BusShard* Bus;
+        UpdateQueue Updates;
+        std::atomic<bool> Idle;      // Not resyncing, set between cycles
+        std::atomic<bool> Finished;
+    };
+
+    // Constructed widget of a sensor and the heap it took
+    struct Widget {
+        BaseSensor* Sensor;
+        size_t Bytes;
+    };
+
+    std::vector<BaseSensor*> Sensors; ///< Sensors of all buses, in display order.
+    SensorIndex Index;                ///< Sensors of all buses by UID.
+    std::vector<BaseSensor*> Shown;   ///< Visible sensors, the only ones redrawn.
+    std::vector<Widget> Widgets;      ///< Constructed widgets, least recently shown first.
+    size_t WidgetHeap;                ///< Heap taken by the constructed widgets [B].
+    const BaseSensor* Leaving;        ///< Sensor hidden last, its navigation button may be handling an event.
+    std::vector<BusShard*> Buses;     ///< Shards of the buses, the primary bus (global messenger) first.
     size_t currentIndex;
+    bool CaseSensitive;   ///< Flag if keys of received frames are matched case-sensitive.
+    std::vector<CommTask*> Tasks; ///< Communication tasks, one per bus, empty if not threaded.
+    std::atomic<bool> Running;    ///< Flag if the communication tasks should keep running.
+    std::atomic<bool> Paused;     ///< Flag if the communication tasks should wait between resyncs.
 };
 
 #endif // MANAGER_HPP
\ No newline at end of file
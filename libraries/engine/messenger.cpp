@@ -1,12 +1,16 @@
 /**
  * @file messenger.cpp
  * @brief Definition of the messenger interface and related global functions.
- * 
+ *
  * This header defines the global functions for message operations. It includes configuration
  * and exception handling support..
- * 
+ *
+ * Received bytes are queued by the transport (UART event task on Arduino, reader thread
+ * on host) and assembled into messages by the polling side, so no call blocks the UI loop
+ * unless it explicitly waits for a response.
+ *
  * @copyright 2024 MTA
- * @author 
+ * @author
  * Ing. Jiri Konecny
  */
 
@@ -14,63 +18,190 @@
  #define MESSANGER_HPP
 
 #include "messenger.hpp"
+#include "helpers.hpp" ///< getTimeMs, sleepMs.
+#include "logs.hpp"    ///< logMessage.
 
-#ifdef ARDUINO_H
-    #include <Arduino.h>  ///< Include Arduino 
-    #include <HardwareSerial.h> ///< Include Arduino Serial functions
+/**
+ * @brief Let the receiving side run while waiting for a response.
+ */
+static void waitForData() {
+    sleepMs(1);
+}
+
+/**************************************************************************/
+// MESSENGER
+/**************************************************************************/
 
-    HardwareSerial UART1(UART1_PORT);
+Messenger::Messenger(Transport *transport)
+ : Link(transport), Assembler(FRAME_DELIMITER), PendingPos(0), PendingLen(0), Requests(), Outstanding(0),
+   NextRequest(0), Expired(0), Stale(0)
+{
+}
 
-    void sendMessage(const std::string &message) {
-        UART1.println(message.c_str());
+void Messenger::setTransport(Transport *transport) {
+    Link = transport;
+    Assembler = FrameAssembler<UART_FRAME_MAX>(FRAME_DELIMITER);
+    PendingPos = 0;
+    PendingLen = 0;
+}
+
+bool Messenger::begin() {
+    return Link && Link->begin();
+}
+
+void Messenger::send(std::string_view message) {
+    if (!Link) {
+        return;
     }
-    
-    std::string receiveMessage() {
-        String msg = ""; // static so it persists between calls
-        unsigned long startTime = millis();
+    const char delimiter = FRAME_DELIMITER;
+    Link->send(message.data(), message.size());
+    Link->send(&delimiter, 1);
+}
 
-        while (UART1.available() == 0 && (millis() - startTime) < UART_TIMEOUT) {
-          // Wait until data arrives or timeout occurs
+bool Messenger::send() {
+    if (!Link) {
+        return false;
+    }
+    Tx.append(FRAME_DELIMITER);
+    if (Tx.overflow()) {
+        logMessage("Request exceeds %d B, not sent.\n", TX_FRAME_MAX);
+        return false;
+    }
+    Link->send(Tx.view().data(), Tx.size());
+    return true;
+}
+
+bool Messenger::poll(std::string_view &message) {
+    if (!Link) {
+        return false;
+    }
+    for (;;) {
+        while (PendingPos < PendingLen) {
+            if (Assembler.feed(Pending[PendingPos++])) {
+                message = Assembler.frame();
+                return true;
+            }
+        }
+        PendingPos = 0;
+        PendingLen = Link->receive(Pending, sizeof(Pending));
+        if (PendingLen == 0) {
+            return false;
         }
+    }
+}
 
-        if (Serial.available() > 0) {
-          // Read response
-          msg = UART1.readString();
-        } else {
-          // Handle timeout situation
-          // Do nothing
+bool Messenger::wait(std::string_view &message, unsigned long timeout) {
+    unsigned long start = getTimeMs();
+    while (!poll(message)) {
+        if (getTimeMs() - start >= timeout) {
+            return false; // Handle timeout situation
         }
+        waitForData();
+    }
+    return true;
+}
+
+void Messenger::receive(std::string &buffer, unsigned long timeout) {
+    buffer.clear();
+    std::string_view message;
+    if (wait(message, timeout)) {
+        buffer.assign(message.data(), message.size());
+    }
+}
 
-        return std::string(msg.c_str());
+long Messenger::request(size_t tag, unsigned long timeout) {
+    if (!Link || Outstanding == MAX_PENDING_REQUESTS) {
+        return -1;
     }
-    
-    void initMessenger(unsigned long baudrate = UART1_BAUDRATE, unsigned int mode = SERIAL_8N1, int tx = UART1_TX, int rx = UART1_RX) {
-        UART1.begin(baudrate, mode, tx, rx);
-        while(!UART1);
+    PendingRequest *entry = Requests;
+    while (entry->Number >= 0) {
+        ++entry;
     }
 
-    void initMessenger() {
-        initMessenger(UART1_BAUDRATE, SERIAL_8N1, UART1_TX, UART1_RX);
+    long number = NextRequest;
+    Tx.field("req", static_cast<int>(number));
+    if (!send()) {
+        return -1;
     }
+    NextRequest = (NextRequest + 1) & 0x7FFFFFFF;
 
-#elif defined(STDIO_H)
-    #include <stdio.h>    ///< Include standard I/O functions
+    entry->Number = number;
+    entry->SentMs = getTimeMs();
+    entry->TimeoutMs = timeout;
+    entry->Tag = tag;
+    ++Outstanding;
+    return number;
+}
 
-    void sendMessage(const std::string &message) {
-        printf("%s\n", message.c_str());
+bool Messenger::complete(long number, size_t &tag) {
+    for (PendingRequest &entry : Requests) {
+        if (entry.Number >= 0 && entry.Number == number) {
+            tag = entry.Tag;
+            entry.Number = -1;
+            --Outstanding;
+            return true;
+        }
     }
+    ++Stale;
+    return false;
+}
 
-    std::string receiveMessage() {
-        char buffer[256];
-        scanf("%s", buffer);
-        return std::string(buffer);
+void Messenger::flush() {
+    if (Link) {
+        Link->flush();
     }
+}
 
-    void initMessenger() {
-        // No initialization needed for standard I/O
-        return;
-    }
-    
+TransportStats Messenger::stats() const {
+    return Link ? Link->stats() : TransportStats();
+}
+
+/**************************************************************************/
+// GLOBAL FUNCTIONS
+/**************************************************************************/
+
+Messenger &getMessenger() {
+    static Messenger messenger;
+    return messenger;
+}
+
+void sendMessage(const std::string &message) {
+    getMessenger().send(message);
+}
+
+void receiveMessage(std::string &buffer, unsigned long timeout) {
+    getMessenger().receive(buffer, timeout);
+}
+
+std::string receiveMessage(unsigned long timeout) {
+    std::string buffer;
+    receiveMessage(buffer, timeout);
+    return buffer;
+}
+
+bool pollMessage(std::string_view &message) {
+    return getMessenger().poll(message);
+}
+
+size_t getDroppedBytes() {
+    return getMessenger().stats().DroppedBytes;
+}
+
+#ifdef ARDUINO_H
+void initMessenger(unsigned long baudrate, unsigned int mode, int tx, int rx) {
+    SerialTransport &transport = static_cast<SerialTransport&>(getDefaultTransport());
+    transport.configure(baudrate, mode, tx, rx);
+    getMessenger().setTransport(&transport);
+    getMessenger().begin();
+}
 #endif
 
-#endif // MESSANGER_HPP
\ No newline at end of file
+void initMessenger() {
+    Messenger &messenger = getMessenger();
+    if (!messenger.getTransport()) {
+        messenger.setTransport(&getDefaultTransport());
+    }
+    messenger.begin();
+}
+
+#endif // MESSANGER_HPP
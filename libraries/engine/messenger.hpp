@@ -1,42 +1,281 @@
 /**
  * @file messenger.hpp
  * @brief Declaration of the messenger interface and related global functions.
- * 
- * This header declares the global functions for message operations. It includes configuration
- * and exception handling support.
- * 
+ *
+ * This header declares the Messenger class, which frames messages over a byte transport,
+ * and the global functions for message operations over the global messenger. It includes
+ * configuration and exception handling support.
+ *
  * @copyright 2024 MTA
- * @author 
+ * @author
  * Ing. Jiri Konecny
  */
 
  #ifndef MESSENGER_HPP
  #define MESSENGER_HPP
- 
- #include "config.hpp"     ///< Configuration.
- #include "exceptions.hpp" ///< Exception handling.
+
+ #include "config.hpp"          ///< Configuration.
+ #include "exceptions.hpp"      ///< Exception handling.
+ #include "frame_assembler.hpp" ///< FrameAssembler.
+#include "frame_builder.hpp"   ///< FrameBuilder.
+#include "helpers.hpp"         ///< getTimeMs.
+ #include "transport.hpp"       ///< Transport.
+ #include <cstddef>
  #include <string>
- 
+ #include <string_view>
+
+/**
+ * @class Messenger
+ * @brief Sends and receives messages delimited by FRAME_DELIMITER over a transport.
+ *
+ * The transport is injected and not owned by the messenger.
+ */
+class Messenger
+{
+public:
+    /**
+     * @brief Constructs a new Messenger object.
+     *
+     * @param transport The transport, may be set later.
+     */
+    Messenger(Transport *transport = nullptr);
+
+    Messenger(const Messenger&) = delete;
+    Messenger& operator=(const Messenger&) = delete;
+
+    /**
+     * @brief Set the transport, partially received message is discarded.
+     */
+    void setTransport(Transport *transport);
+
+    /**
+     * @brief Get the transport (nullptr if not set).
+     */
+    Transport *getTransport() const { return Link; }
+
+    /**
+     * @brief Open the transport.
+     *
+     * @return true if the transport is open.
+     */
+    bool begin();
+
+    /**
+     * @brief Send message, the delimiter is appended.
+     *
+     * The message is queued by the transport, the call does not wait until it leaves (see flush()).
+     *
+     * @param message The message to send.
+     */
+    void send(std::string_view message);
+
+    /**
+     * @brief Start a new outbound frame in the send buffer.
+     *
+     * The frame is built in place, e.g. compose().command("UPDATE").field("id", 4),
+     * and sent by send() or request(). Nothing is allocated.
+     *
+     * @return The cleared builder of the frame.
+     */
+    FrameBuilder &compose() { return Tx.clear(); }
+
+    /**
+     * @brief Send the composed frame, the delimiter is appended.
+     *
+     * The frame is queued by the transport, the call does not wait until it leaves (see flush()).
+     *
+     * @return true if sent, false if there is no transport or the frame did not fit TX_FRAME_MAX.
+     */
+    bool send();
+
+    /**
+     * @brief Poll for a complete received message, never blocks.
+     *
+     * @param message The message without the delimiter, valid until the next poll or receive.
+     * @return true if a message is complete, false otherwise.
+     */
+    bool poll(std::string_view &message);
+
+    /**
+     * @brief Wait for a complete received message.
+     *
+     * @param message The message without the delimiter, valid until the next poll or receive.
+     * @param timeout The maximal wait [ms].
+     * @return true if a message is complete, false on timeout.
+     */
+    bool wait(std::string_view &message, unsigned long timeout = UART_TIMEOUT);
+
+    /**
+     * @brief Receive message into the given buffer, waits until it is complete.
+     *
+     * @param buffer The buffer for the received message (empty on timeout).
+     * @param timeout The maximal wait [ms].
+     */
+    void receive(std::string &buffer, unsigned long timeout = UART_TIMEOUT);
+
+    /**
+     * @brief Send the composed frame as numbered request, "&req=<number>" is appended.
+     *
+     * The request stays outstanding until complete() is called with the number echoed
+     * by the reply, or until it expires. Replies may arrive in any order.
+     *
+     * @param tag The caller's identification of the request, returned by complete().
+     * @param timeout The reply deadline of the request [ms].
+     * @return The request number, -1 if MAX_PENDING_REQUESTS requests are outstanding
+     *         or the frame did not fit TX_FRAME_MAX.
+     */
+    long request(size_t tag, unsigned long timeout = UART_TIMEOUT);
+
+    /**
+     * @brief Complete outstanding request.
+     *
+     * @param number The request number echoed by the reply.
+     * @param tag The tag given to request().
+     * @return true if the request was outstanding, false for a late or duplicate reply.
+     */
+    bool complete(long number, size_t &tag);
+
+    /**
+     * @brief Drop outstanding requests past their reply deadline.
+     *
+     * @param onExpired Callable invoked with the tag of each dropped request.
+     * @return The number of dropped requests.
+     */
+    template <typename F>
+    size_t expire(F &&onExpired)
+    {
+        unsigned long now = getTimeMs();
+        size_t count = 0;
+        for (PendingRequest &entry : Requests) {
+            if (entry.Number >= 0 && now - entry.SentMs >= entry.TimeoutMs) {
+                entry.Number = -1;
+                --Outstanding;
+                ++count;
+                onExpired(entry.Tag);
+            }
+        }
+        Expired += count;
+        return count;
+    }
+
+    /**
+     * @brief Get number of outstanding requests.
+     */
+    size_t outstanding() const { return Outstanding; }
+
+    /**
+     * @brief Get number of requests dropped without reply.
+     */
+    size_t expiredRequests() const { return Expired; }
+
+    /**
+     * @brief Get number of replies to requests no longer outstanding.
+     */
+    size_t staleReplies() const { return Stale; }
+
+    /**
+     * @brief Wait until all sent bytes left.
+     *
+     * Blocks on the wire (the TX FIFO of the UART), call only where the drain is needed.
+     */
+    void flush();
+
+    /**
+     * @brief Get traffic counters of the transport.
+     */
+    TransportStats stats() const;
+
+    /**
+     * @brief Set the length-delimited frames agreed with the device, see FrameAssembler::setFraming.
+     */
+    void setFraming(bool binary, bool checked) { Assembler.setFraming(binary, checked); }
+
+    /**
+     * @brief Get number of received messages.
+     */
+    size_t frames() const { return Assembler.frames(); }
+
+    /**
+     * @brief Get number of received messages dropped as too long.
+     */
+    size_t overflows() const { return Assembler.overflows(); }
+
+private:
+    /**
+     * @brief Numbered request awaiting reply.
+     */
+    struct PendingRequest
+    {
+        long Number = -1;           ///< Request number, -1 for a free entry.
+        unsigned long SentMs = 0;   ///< Time the request was sent.
+        unsigned long TimeoutMs = 0;///< Reply deadline, from SentMs.
+        size_t Tag = 0;             ///< Caller's identification of the request.
+    };
+
+    Transport *Link;                            ///< Transport.
+    FrameBuilder Tx;                            ///< Send buffer of composed frames.
+    FrameAssembler<UART_FRAME_MAX> Assembler;   ///< Assembly of received messages.
+    char Pending[64];                           ///< Bytes read from the transport, not yet assembled.
+    size_t PendingPos;                          ///< Position of the next pending byte.
+    size_t PendingLen;                          ///< Number of pending bytes.
+    PendingRequest Requests[MAX_PENDING_REQUESTS]; ///< Outstanding requests.
+    size_t Outstanding;                         ///< Number of outstanding requests.
+    long NextRequest;                           ///< Number of the next request.
+    size_t Expired;                             ///< Number of requests dropped without reply.
+    size_t Stale;                               ///< Number of replies to no longer outstanding requests.
+};
+
+ /**
+  * @brief Get the global messenger, used by the global functions.
+  */
+ Messenger &getMessenger();
 
  /**
   * @brief Sends a message using the global messenger.
-  * 
+  *
   * @param message The message to send.
   * @throws Exception if sending fails.
   */
  void sendMessage(const std::string &message);
- 
+
  /**
-  * @brief Receives a message using the global messenger.
-  * 
-  * @return A string containing the received message.
+  * @brief Receives a message using the global messenger, waits until it is complete.
+  *
+  * @param timeout The maximal wait [ms].
+  * @return A string containing the received message (empty on timeout).
   * @throws Exception if receiving fails.
   */
- std::string receiveMessage();
- 
+ std::string receiveMessage(unsigned long timeout = UART_TIMEOUT);
+
+ /**
+  * @brief Receives a message using the global messenger into the given buffer.
+  *
+  * The buffer is overwritten and its capacity is reused, so repeated receives into
+  * the same buffer do not allocate once it is large enough.
+  *
+  * @param buffer The buffer for the received message (empty on timeout).
+  * @param timeout The maximal wait [ms].
+  * @throws Exception if receiving fails.
+  */
+ void receiveMessage(std::string &buffer, unsigned long timeout = UART_TIMEOUT);
+
+ /**
+  * @brief Poll for a complete message received by the global messenger, never blocks.
+  *
+  * @param message The message without the delimiter, valid until the next poll or receive.
+  * @return true if a message is complete, false otherwise.
+  */
+ bool pollMessage(std::string_view &message);
+
+ /**
+  * @brief Get number of received bytes dropped because the receive buffer was full.
+  */
+ size_t getDroppedBytes();
+
+#ifdef ARDUINO_H
 /**
-* @brief Initializes the global messenger.
-* 
+* @brief Initializes the global messenger with the UART1 transport.
+*
 * @param baudrate The baudrate for the messenger.
 * @param mode The mode for the messenger.
 * @param tx The transmit pin for the messenger.
@@ -44,13 +283,16 @@
 * @throws Exception if initialization fails.
 */
  void initMessenger(unsigned long baudrate, unsigned int mode, int tx, int rx);
+#endif
 
   /**
   * @brief Initializes the global messenger.
-  * 
+  *
+  * Uses the default transport of the platform, unless a transport was injected
+  * by getMessenger().setTransport().
+  *
   * @throws Exception if initialization fails.
   */
  void initMessenger();
- 
+
  #endif // MESSENGER_HPP
- 
\ No newline at end of file
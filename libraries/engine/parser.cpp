@@ -9,7 +9,6 @@
 #include "parser.hpp"
 
 #include <cstdio>
-#include <algorithm> // For std::transform
 
 /**********************
  *      TYPEDEFS
@@ -39,12 +38,9 @@ int IsValid(const SensorMetadata* metadata, const std::string &uid)
     return CheckMetadata(metadata) && metadata->UID == uid;
 }
 
-SensorMetadata ParseMetadata(std::string &response, bool caseSensitive)
+SensorMetadata ParseMetadata(std::string_view response, bool caseSensitive)
 {
     SensorMetadata metadata;
-    metadata.UID = "";
-    metadata.Status = "";
-    metadata.Data = "";
 
     //Check request format
     if(response.size() < 1 )
@@ -54,31 +50,130 @@ SensorMetadata ParseMetadata(std::string &response, bool caseSensitive)
 
     //Get rid of the '?' character
     if(response[0] == '?'){
-        response.erase(0, 1);
+        response.remove_prefix(1);
     }
 
-    if(!caseSensitive)
+    //Parse ID, Status, sequence and request number from request, first occurrence wins
+    std::string_view cursor(response);
+    KeyValueToken token;
+    while(nextKeyValueToken(cursor, token, '&'))
     {
-        // Convert to lowercase
-        std::transform(response.begin(), response.end(), response.begin(), ::tolower);
+        if(metadata.UID.empty() && equalsKey(token.Key, "id", caseSensitive))
+        {
+            metadata.UID = token.Value;
+        }
+        else if(metadata.Status.empty() && equalsKey(token.Key, "status", caseSensitive))
+        {
+            metadata.Status = token.Value;
+        }
+        else if(metadata.Seq < 0 && equalsKey(token.Key, "seq", caseSensitive))
+        {
+            int seq = -1;
+            if(parseNumber(token.Value, seq) == ParseStatus::OK && seq >= 0)
+            {
+                metadata.Seq = seq;
+            }
+        }
+        else if(metadata.Req < 0 && equalsKey(token.Key, "req", caseSensitive))
+        {
+            int req = -1;
+            if(parseNumber(token.Value, req) == ParseStatus::OK && req >= 0)
+            {
+                metadata.Req = req;
+            }
+        }
     }
+    
+    //Save the rest of the request as data
+    metadata.Data = response;
+
+    return metadata;
+}
+
+SensorMetadata ParseBinaryMetadata(std::string_view frame)
+{
+    SensorMetadata metadata;
+    metadata.Format = WireFormat::BINARY;
 
-    //Parse ID from request
-    std::string uid = getValueFromKeyValueLikeString(response, "id", '&');
-    if(!uid.empty())
+    //UID length byte and UID
+    if(frame.empty() || frame.size() < 1u + static_cast<uint8_t>(frame[0]))
     {
-        metadata.UID = uid;
+        return metadata;
     }
+    size_t length = static_cast<uint8_t>(frame[0]);
+    metadata.UID = frame.substr(1, length);
 
-    //Parse Status from request
-    std::string status = getValueFromKeyValueLikeString(response, "status", '&');
-    if(!status.empty())
+    //Fields follow the UID, sequence and request number lead them
+    metadata.Data = frame.substr(1 + length);
+    while(metadata.Data.size() >= BINARY_FIELD_SIZE)
     {
-        metadata.Status = status;
+        long number = static_cast<long>(readUint32LE(metadata.Data.data() + 1) & 0x7FFFFFFF);
+        uint8_t id = static_cast<uint8_t>(metadata.Data[0]);
+        if(id == SEQUENCE_FIELD_ID && metadata.Seq < 0)
+        {
+            metadata.Seq = number;
+        }
+        else if(id == REQUEST_FIELD_ID && metadata.Req < 0)
+        {
+            metadata.Req = number;
+        }
+        else
+        {
+            break;
+        }
+        metadata.Data.remove_prefix(BINARY_FIELD_SIZE);
     }
-    
-    //Save the rest of the request as data
-    metadata.Data = response;
 
     return metadata;
-}
\ No newline at end of file
+}
+
+WireFormat ParseWireFormat(std::string_view response)
+{
+    std::string_view cursor(response);
+    KeyValueToken token;
+    while(nextKeyValueToken(cursor, token, '&'))
+    {
+        if(equalsKey(token.Key, "format", false))
+        {
+            return equalsKey(token.Value, WireFormatName(WireFormat::BINARY), false) ? WireFormat::BINARY : WireFormat::TEXT;
+        }
+    }
+    return WireFormat::TEXT;
+}
+
+const char* WireFormatName(WireFormat format)
+{
+    return format == WireFormat::BINARY ? "binary" : "text";
+}
+
+bool ParseSensorDeclaration(std::string_view &cursor, SensorDeclaration &declaration)
+{
+    while(!cursor.empty())
+    {
+        //Get rid of the '?' character
+        if(cursor[0] == '?')
+        {
+            cursor.remove_prefix(1);
+            continue;
+        }
+
+        size_t end = cursor.find('&');
+        std::string_view entry = cursor.substr(0, end);
+        cursor.remove_prefix(end == std::string_view::npos ? cursor.size() : end + 1);
+
+        //Skip options of the response
+        if(entry.find('=') != std::string_view::npos)
+        {
+            continue;
+        }
+
+        size_t colon = entry.find(':');
+        declaration.UID = trimView(entry.substr(0, colon));
+        declaration.Type = colon == std::string_view::npos ? std::string_view() : trimView(entry.substr(colon + 1));
+        if(!declaration.UID.empty())
+        {
+            return true;
+        }
+    }
+    return false;
+}
@@ -12,19 +12,66 @@
 #include "exceptions.hpp"
 #include "helpers.hpp"
 #include <string>
+#include <string_view>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TEXT_FRAME_MARKER '?'   ///< Start of text frame.
+#define BINARY_FRAME_MARKER '!' ///< Start of binary frame, reserved in text frames.
+#define BINARY_FIELD_SIZE 5     ///< Size of binary field, field id + 32-bit value.
+#define SEQUENCE_FIELD_ID 0xFF  ///< Binary field id of the sequence number.
+#define REQUEST_FIELD_ID 0xFE   ///< Binary field id of the answered request number.
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+/**
+ * @enum WireFormat
+ * @brief Format of the update frames, negotiated by "?INIT&format=binary".
+ * 
+ * - TEXT: "?id=4&Temperature=27&acm_x=-3" key-value frames.
+ * - BINARY: "!" marker, payload length byte and the payload:
+ *   UID length byte, UID and fields of BINARY_FIELD_SIZE bytes each. A field is
+ *   the value position in the sensor values schema (one byte) and the value as
+ *   32-bit little-endian word, int32 for INT and float32 for FLOAT and DOUBLE values.
+ *   The sequence number of delta frames is sent as the first field, with SEQUENCE_FIELD_ID.
+ *   A reply to a numbered request ("?UPDATE&id=4&req=7") leads with the echoed request
+ *   number, with REQUEST_FIELD_ID ("req=7" key in text frames). Sensors listed by one
+ *   request ("?UPDATE&id=4,8") answer by one frame each.
+ */
+enum class WireFormat
+{
+  TEXT,
+  BINARY
+};
+
 /**
  * @brief Structure to hold sensor metadata.
+ * 
+ * All members are views into the parsed frame, they are valid only as long as
+ * the frame buffer is alive and unchanged.
  */
 struct SensorMetadata
 {
-  std::string UID;
-  std::string Status;
-  std::string Data;
+  std::string_view UID;
+  std::string_view Status;
+  std::string_view Data;
+  WireFormat Format = WireFormat::TEXT; ///< Format of Data.
+  long Seq = -1;                        ///< Sequence number of delta frame, -1 if the frame has none.
+  long Req = -1;                        ///< Number of the answered request, -1 if the frame has none.
+};
+
+/**
+ * @brief Structure to hold one sensor declaration of the init response (e.g. "0:ADC").
+ * 
+ * All members are views into the parsed response.
+ */
+struct SensorDeclaration
+{
+  std::string_view UID;
+  std::string_view Type;
 };
 
 /*********************
@@ -51,10 +98,106 @@ int CheckMetadata(const SensorMetadata* metadata);
 /**
  * @brief Parse metadata from a request string.
  * 
+ * The frame is not copied nor modified, the metadata points into it.
+ * 
  * @param response The request string to parse.
- * @param caseSensitive Flag to indicate if parsing should be case-sensitive.
+ * @param caseSensitive Flag to indicate if the metadata keys should be matched case-sensitive.
  * @return The parsed metadata.
  */
-SensorMetadata ParseMetadata(std::string &request, bool caseSensitive = false);
+SensorMetadata ParseMetadata(std::string_view response, bool caseSensitive = false);
+
+/**
+ * @brief Parse metadata from a binary frame payload.
+ * 
+ * The payload is not copied, the metadata points into it.
+ * 
+ * @param frame The frame payload, without the marker and length byte.
+ * @return The parsed metadata (empty UID if the payload is truncated).
+ */
+SensorMetadata ParseBinaryMetadata(std::string_view frame);
+
+/**
+ * @brief Parse the negotiated frame format from the init response.
+ * 
+ * @param response The init response (e.g. "?0:ADC&1:TH&format=binary").
+ * @return BINARY if the device confirmed the binary format, TEXT otherwise.
+ */
+WireFormat ParseWireFormat(std::string_view response);
+
+/**
+ * @brief Get name of the frame format, as used in "?INIT&format=<name>".
+ */
+const char* WireFormatName(WireFormat format);
+
+/**
+ * @brief Split batch of text and binary frames and dispatch each of them.
+ * 
+ * Text frames start with TEXT_FRAME_MARKER and end at the next marker of either
+ * format, binary frames are delimited by their length byte, so their payload may
+ * contain any byte. A truncated binary frame at the end of the batch is dropped.
+ * BINARY_FRAME_MARKER starts a frame only once the binary format was negotiated,
+ * on a text link it is an ordinary character of the values (e.g. "Status=Error!").
+ * Nothing is copied, every frame is a view into the batch.
+ * 
+ * @param buffer The batch of frames.
+ * @param format The negotiated format of the link, BINARY splits on both markers.
+ * @param dispatch Callable invoked as dispatch(std::string_view frame, WireFormat format),
+ *        text frames without the marker, binary ones as the payload only.
+ * @return The number of dispatched frames.
+ */
+template <typename Dispatch>
+size_t forEachWireFrame(std::string_view buffer, WireFormat format, Dispatch &&dispatch)
+{
+  const bool binaryLink = format == WireFormat::BINARY;
+  size_t count = 0;
+  while(!buffer.empty())
+  {
+    if(binaryLink && buffer[0] == BINARY_FRAME_MARKER)
+    {
+      size_t length = buffer.size() > 1 ? static_cast<uint8_t>(buffer[1]) : 0;
+      if(buffer.size() < 2 + length)
+      {
+        break;
+      }
+      dispatch(buffer.substr(2, length), WireFormat::BINARY);
+      buffer.remove_prefix(2 + length);
+      ++count;
+      continue;
+    }
+
+    if(buffer[0] == TEXT_FRAME_MARKER)
+    {
+      buffer.remove_prefix(1);
+    }
+    size_t end = buffer.find(TEXT_FRAME_MARKER);
+    size_t binary = binaryLink ? buffer.substr(0, end).find(BINARY_FRAME_MARKER) : std::string_view::npos;
+    if(binary != std::string_view::npos)
+    {
+      end = binary;
+    }
+    std::string_view frame = buffer.substr(0, end);
+    buffer.remove_prefix(frame.size());
+    if(!frame.empty())
+    {
+      dispatch(frame, WireFormat::TEXT);
+      ++count;
+    }
+  }
+
+  return count;
+}
+
+/**
+ * @brief Parse next sensor declaration from the init response (e.g. "?0:ADC&1:TH").
+ * 
+ * The cursor is advanced past the parsed declaration. Empty entries, entries
+ * without an UID and options (e.g. "format=binary") are skipped, an entry
+ * without ':' has an empty type.
+ * 
+ * @param cursor The rest of the response to parse, advanced by the call.
+ * @param declaration The parsed declaration.
+ * @return true if a declaration was parsed, false if the response is exhausted.
+ */
+bool ParseSensorDeclaration(std::string_view &cursor, SensorDeclaration &declaration);
 
 #endif //__PARSER_H_
\ No newline at end of file
@@ -0,0 +1,201 @@
+/**
+ * @file recording.cpp
+ * @brief Definition of the recording and replay transports.
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "recording.hpp"
+#include "helpers.hpp" ///< getTimeUs, readUint32LE, writeUint32LE.
+#include "logs.hpp"    ///< logMessage.
+
+#include <algorithm>
+#include <cstring>
+
+/**************************************************************************/
+// RECORDING
+/**************************************************************************/
+
+RecordingTransport::RecordingTransport(Transport &link, std::string path)
+ : Link(link), Path(std::move(path)), File(nullptr), LastUs(0), Records(0)
+{
+}
+
+RecordingTransport::~RecordingTransport()
+{
+    close();
+}
+
+bool RecordingTransport::begin()
+{
+    if (!File) {
+        File = fopen(Path.c_str(), "wb");
+        if (!File) {
+            logMessage("Unable to create recording %s!\n", Path.c_str());
+        } else {
+            fwrite(RECORDING_MAGIC, 1, RECORDING_MAGIC_SIZE, File);
+            LastUs = getTimeUs();
+        }
+    }
+    return Link.begin();
+}
+
+size_t RecordingTransport::send(const char *data, size_t size)
+{
+    size_t sent = Link.send(data, size);
+    record(RECORD_OUTBOUND, data, sent);
+    return sent;
+}
+
+size_t RecordingTransport::receive(char *data, size_t size)
+{
+    size_t count = Link.receive(data, size);
+    record(RECORD_INBOUND, data, count);
+    return count;
+}
+
+void RecordingTransport::flush()
+{
+    Link.flush();
+    if (File) {
+        fflush(File);
+    }
+}
+
+void RecordingTransport::close()
+{
+    if (File) {
+        fclose(File);
+        File = nullptr;
+    }
+}
+
+void RecordingTransport::record(char direction, const char *data, size_t size)
+{
+    if (!File) {
+        return;
+    }
+    while (size > 0) {
+        size_t length = std::min<size_t>(size, 0xFFFF);
+        unsigned long now = getTimeUs();
+        char header[RECORD_HEADER_SIZE];
+        header[0] = direction;
+        writeUint32LE(header + 1, static_cast<uint32_t>(now - LastUs));
+        header[5] = static_cast<char>(length & 0xFF);
+        header[6] = static_cast<char>(length >> 8);
+        fwrite(header, 1, sizeof(header), File);
+        fwrite(data, 1, length, File);
+        LastUs = now;
+        ++Records;
+        data += length;
+        size -= length;
+    }
+}
+
+/**************************************************************************/
+// REPLAY
+/**************************************************************************/
+
+ReplayTransport::ReplayTransport(std::string path, double speed)
+ : Path(std::move(path)), Data(), Speed(speed), Cursor(0), Remaining(0), RecordUs(0), ClockUs(0), LastUs(0)
+{
+}
+
+bool ReplayTransport::begin()
+{
+    Data.clear();
+    FILE *file = fopen(Path.c_str(), "rb");
+    if (file) {
+        char chunk[512];
+        size_t count;
+        while ((count = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            Data.append(chunk, count);
+        }
+        fclose(file);
+    }
+    if (Data.compare(0, RECORDING_MAGIC_SIZE, RECORDING_MAGIC) != 0) {
+        logMessage("Invalid recording %s!\n", Path.c_str());
+        Data.clear();
+        rewind();
+        return false;
+    }
+    rewind();
+    return true;
+}
+
+size_t ReplayTransport::send(const char *data, size_t size)
+{
+    (void)data;
+    return countSent(size, size);
+}
+
+size_t ReplayTransport::receive(char *data, size_t size)
+{
+    unsigned long now = getTimeUs();
+    ClockUs += static_cast<unsigned long long>((now - LastUs) * Speed);
+    LastUs = now;
+
+    size_t count = 0;
+    while (count < size) {
+        if (Remaining == 0 && !nextRecord()) {
+            break;
+        }
+        size_t length = std::min(Remaining, size - count);
+        memcpy(data + count, Data.data() + Cursor, length);
+        Cursor += length;
+        Remaining -= length;
+        count += length;
+    }
+    Stats.BytesReceived += count;
+    return count;
+}
+
+void ReplayTransport::setSpeed(double speed)
+{
+    Speed = speed;
+}
+
+void ReplayTransport::rewind()
+{
+    Cursor = Data.empty() ? 0 : RECORDING_MAGIC_SIZE;
+    Remaining = 0;
+    RecordUs = 0;
+    ClockUs = 0;
+    LastUs = getTimeUs();
+}
+
+bool ReplayTransport::nextRecord()
+{
+    // Outbound records only advance the time, the next due inbound record is released.
+    while (Cursor < Data.size()) {
+        if (Data.size() - Cursor < RECORD_HEADER_SIZE) {
+            Cursor = Data.size(); // Truncated recording.
+            return false;
+        }
+        const char *header = Data.data() + Cursor;
+        unsigned long long at = RecordUs + readUint32LE(header + 1);
+        if (Speed > 0 && at > ClockUs) {
+            return false; // Not due yet.
+        }
+        size_t length = static_cast<uint8_t>(header[5]) | (static_cast<size_t>(static_cast<uint8_t>(header[6])) << 8);
+        Cursor += RECORD_HEADER_SIZE;
+        RecordUs = at;
+        if (Speed <= 0) {
+            ClockUs = at;
+        }
+        if (Data.size() - Cursor < length) {
+            Cursor = Data.size();
+            return false;
+        }
+        if (header[0] == RECORD_INBOUND && length > 0) {
+            Remaining = length;
+            return true;
+        }
+        Cursor += length;
+    }
+    return false;
+}
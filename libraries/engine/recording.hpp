@@ -0,0 +1,151 @@
+/**
+ * @file recording.hpp
+ * @brief Declaration of the recording and replay transports.
+ *
+ * A recording holds the traffic of a transport with monotonic timestamps, so a captured
+ * session can be fed to the manager again, e.g. for repeatable load and profiling runs.
+ *
+ * File format (all numbers little-endian):
+ * @code
+ * "VSR1"                                   magic
+ * { direction, delta_us:u32, length:u16, bytes[length] }*
+ * @endcode
+ * direction is RECORD_INBOUND or RECORD_OUTBOUND, delta_us is the time since the
+ * previous record (since the start of the recording for the first one).
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#ifndef RECORDING_HPP
+#define RECORDING_HPP
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "transport.hpp" ///< Transport.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define RECORDING_MAGIC "VSR1"      ///< Magic of the recording file.
+#define RECORDING_MAGIC_SIZE 4      ///< Size of the magic.
+#define RECORD_HEADER_SIZE 7        ///< Size of the record header (direction, delta, length).
+#define RECORD_INBOUND 'I'          ///< Record of bytes received from the device.
+#define RECORD_OUTBOUND 'O'         ///< Record of bytes sent to the device.
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @class RecordingTransport
+ * @brief Passes all traffic to the wrapped transport and appends it to a recording file.
+ *
+ * Records are written as the bytes pass, a chunk received at once is one record. The file
+ * is flushed by flush() and closed by close() or the destructor.
+ */
+class RecordingTransport : public Transport
+{
+public:
+    /**
+     * @param link The recorded transport, not owned.
+     * @param path The recording file, created (or truncated) by begin().
+     */
+    RecordingTransport(Transport &link, std::string path);
+    ~RecordingTransport() override;
+
+    RecordingTransport(const RecordingTransport&) = delete;
+    RecordingTransport& operator=(const RecordingTransport&) = delete;
+
+    bool begin() override;
+    size_t send(const char *data, size_t size) override;
+    size_t receive(char *data, size_t size) override;
+    void flush() override;
+    TransportStats stats() const override { return Link.stats(); }
+
+    /**
+     * @brief Close the recording file, the traffic still passes.
+     */
+    void close();
+
+    /**
+     * @brief Get number of written records.
+     */
+    size_t records() const { return Records; }
+
+private:
+    Transport &Link;          ///< Recorded transport.
+    std::string Path;         ///< Recording file path.
+    FILE *File;               ///< Recording file, nullptr if not open.
+    unsigned long LastUs;     ///< Time of the previous record.
+    size_t Records;           ///< Number of written records.
+
+    void record(char direction, const char *data, size_t size);
+};
+
+/**
+ * @class ReplayTransport
+ * @brief Plays inbound records of a recording as received bytes.
+ *
+ * The records are released at their recorded times scaled by the speed, a speed of 0
+ * releases everything at once. Sent bytes are counted and discarded, the replay does
+ * not depend on the requests of the manager.
+ */
+class ReplayTransport : public Transport
+{
+public:
+    /**
+     * @param path The recording file, loaded by begin().
+     * @param speed The replay speed (1 original, 2 twice as fast, 0 as fast as possible).
+     */
+    ReplayTransport(std::string path, double speed = 1.0);
+
+    /**
+     * @brief Load the recording and start the replay clock.
+     *
+     * @return true if the file is a recording.
+     */
+    bool begin() override;
+    size_t send(const char *data, size_t size) override;
+    size_t receive(char *data, size_t size) override;
+
+    /**
+     * @brief Set the replay speed, applies from the next released record.
+     */
+    void setSpeed(double speed);
+
+    /**
+     * @brief Start the replay from the beginning.
+     */
+    void rewind();
+
+    /**
+     * @brief Check if all inbound records were released.
+     */
+    bool finished() const { return Cursor >= Data.size(); }
+
+    /**
+     * @brief Get recorded duration of the released records [us].
+     */
+    unsigned long long position() const { return RecordUs; }
+
+private:
+    std::string Path;           ///< Recording file path.
+    std::string Data;           ///< Loaded recording.
+    double Speed;               ///< Replay speed, 0 for as fast as possible.
+    size_t Cursor;              ///< Offset of the next record.
+    size_t Remaining;           ///< Unreleased bytes of the current inbound record.
+    unsigned long long RecordUs;    ///< Recorded time of the current record.
+    unsigned long long ClockUs;     ///< Replay clock, in recorded time.
+    unsigned long LastUs;       ///< Time of the last replay clock update.
+
+    bool nextRecord();
+};
+
+#endif // RECORDING_HPP
@@ -0,0 +1,137 @@
+/**
+ * @file ring_buffer.hpp
+ * @brief Lock-free single-producer single-consumer ring buffer.
+ *
+ * One context (UART event task, reader thread) writes, another one (UI loop) reads,
+ * neither of them ever blocks nor allocates.
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#ifndef RING_BUFFER_HPP
+#define RING_BUFFER_HPP
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <atomic>
+#include <cstddef>
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @class RingBuffer
+ * @brief Fixed-capacity SPSC queue of trivially copyable elements.
+ *
+ * Head is written by the producer only and Tail by the consumer only, both grow
+ * freely and are masked on access, so the whole capacity is usable.
+ *
+ * @tparam T The element type.
+ * @tparam N The capacity, power of two.
+ */
+template <typename T, size_t N>
+class RingBuffer
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "RingBuffer capacity must be a power of two");
+
+public:
+    RingBuffer() : Head(0), Tail(0) {}
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    /**
+     * @brief Append one element (producer).
+     *
+     * @return true if appended, false if the buffer is full.
+     */
+    bool push(const T &item)
+    {
+        size_t head = Head.load(std::memory_order_relaxed);
+        if (head - Tail.load(std::memory_order_acquire) >= N) {
+            return false;
+        }
+        Items[head & (N - 1)] = item;
+        Head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Append elements (producer).
+     *
+     * @return The number of appended elements, less than count if the buffer got full.
+     */
+    size_t write(const T *items, size_t count)
+    {
+        size_t head = Head.load(std::memory_order_relaxed);
+        size_t space = N - (head - Tail.load(std::memory_order_acquire));
+        if (count > space) {
+            count = space;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            Items[(head + i) & (N - 1)] = items[i];
+        }
+        Head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Remove the oldest element (consumer).
+     *
+     * @return true if an element was removed, false if the buffer is empty.
+     */
+    bool pop(T &item)
+    {
+        size_t tail = Tail.load(std::memory_order_relaxed);
+        if (Head.load(std::memory_order_acquire) == tail) {
+            return false;
+        }
+        item = Items[tail & (N - 1)];
+        Tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest elements (consumer).
+     *
+     * @return The number of removed elements.
+     */
+    size_t read(T *items, size_t count)
+    {
+        size_t tail = Tail.load(std::memory_order_relaxed);
+        size_t available = Head.load(std::memory_order_acquire) - tail;
+        if (count > available) {
+            count = available;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            items[i] = Items[(tail + i) & (N - 1)];
+        }
+        Tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Get number of stored elements (approximate while the other side runs).
+     */
+    size_t size() const { return Head.load(std::memory_order_acquire) - Tail.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Check if the buffer is empty (consumer).
+     */
+    bool empty() const { return size() == 0; }
+
+    /**
+     * @brief Get the capacity.
+     */
+    static constexpr size_t capacity() { return N; }
+
+private:
+    T Items[N];                ///< Elements storage.
+    std::atomic<size_t> Head;  ///< Write position, owned by the producer.
+    std::atomic<size_t> Tail;  ///< Read position, owned by the consumer.
+};
+
+#endif // RING_BUFFER_HPP
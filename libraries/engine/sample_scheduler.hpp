@@ -0,0 +1,117 @@
+/**
+ * @file sample_scheduler.hpp
+ * @brief Sample deadlines of the polled sensors.
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#ifndef SAMPLE_SCHEDULER_HPP
+#define SAMPLE_SCHEDULER_HPP
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @class SampleScheduler
+ * @brief Min-heap of sample deadlines, the earliest one on top.
+ *
+ * Each sensor (by its position in the bus) has one deadline, a tick pops only the due
+ * ones, so its cost follows the number of due sensors, not of all of them. The storage
+ * grows with the sensor count only, rescheduling allocates nothing.
+ *
+ * Times are getTimeMs() values, deadlines are ordered by their signed difference, so they
+ * keep their order across the wrap around of the clock.
+ */
+class SampleScheduler
+{
+public:
+    SampleScheduler() : Heap() {}
+
+    /**
+     * @brief Schedule the sensor.
+     *
+     * @param id The position of the sensor.
+     * @param dueMs The time the sensor is due.
+     */
+    void add(size_t id, unsigned long dueMs)
+    {
+        Heap.push_back({dueMs, id});
+        std::push_heap(Heap.begin(), Heap.end(), later);
+    }
+
+    /**
+     * @brief Take the earliest deadline if it is due.
+     *
+     * @param now The current time.
+     * @param id The position of the due sensor.
+     * @param dueMs The deadline of the due sensor.
+     * @return true if a sensor is due, false otherwise.
+     */
+    bool pop(unsigned long now, size_t &id, unsigned long &dueMs)
+    {
+        if (Heap.empty() || static_cast<long>(now - Heap.front().DueMs) < 0) {
+            return false;
+        }
+        std::pop_heap(Heap.begin(), Heap.end(), later);
+        id = Heap.back().Id;
+        dueMs = Heap.back().DueMs;
+        Heap.pop_back();
+        return true;
+    }
+
+    /**
+     * @brief Move the deadline of the sensor, the others keep theirs.
+     *
+     * @param id The position of the sensor.
+     * @param dueMs The new time the sensor is due.
+     * @return false if the sensor is not scheduled.
+     */
+    bool reschedule(size_t id, unsigned long dueMs)
+    {
+        auto entry = std::find_if(Heap.begin(), Heap.end(), [id](const Entry &e) { return e.Id == id; });
+        if (entry == Heap.end()) {
+            return false;
+        }
+        entry->DueMs = dueMs;
+        std::make_heap(Heap.begin(), Heap.end(), later); // Linear, in place.
+        return true;
+    }
+
+    /**
+     * @brief Remove all deadlines.
+     */
+    void clear() { Heap.clear(); }
+
+    /**
+     * @brief Get number of scheduled sensors.
+     */
+    size_t size() const { return Heap.size(); }
+
+private:
+    /**
+     * @brief Sample deadline of one sensor.
+     */
+    struct Entry
+    {
+        unsigned long DueMs; ///< Time the sensor is due.
+        size_t Id;           ///< Position of the sensor.
+    };
+
+    std::vector<Entry> Heap; ///< Deadlines, heap ordered by later().
+
+    static bool later(const Entry &a, const Entry &b)
+    {
+        return static_cast<long>(a.DueMs - b.DueMs) > 0;
+    }
+};
+
+#endif // SAMPLE_SCHEDULER_HPP
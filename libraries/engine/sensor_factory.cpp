@@ -23,21 +23,15 @@ void createSensorList(std::vector<BaseSensor*> &memory, std::string stringSource
 {
     memory.clear();
     //Expected format: ?0:ADC&1:ADC&2:TH
-    std::vector<std::string> sensorList = splitString(stringSource, '&');
-    logMessage("\t(i)Found %d sensors...\n", sensorList.size());
-    std::string id;
-    std::string type;
+    std::string_view cursor(stringSource);
+    SensorDeclaration declaration;
     BaseSensor* sensor;
 
-    for (std::string sensorStr: sensorList)
+    while (ParseSensorDeclaration(cursor, declaration))
     {
-        logMessage("\tProcessing sensor request: %s\n", sensorStr.c_str());
-        if (sensorStr.empty())
-        {
-            continue;
-        }
-        id = sensorStr.substr(0, sensorStr.find(':'));
-        type = sensorStr.substr(sensorStr.find(':') + 1);
+        std::string id(declaration.UID);
+        std::string type(declaration.Type);
+        logMessage("\tProcessing sensor request: %s:%s\n", id.c_str(), type.c_str());
         sensor = createSensorByType(type, id);
         if (sensor != nullptr)
         {
@@ -45,6 +39,7 @@ void createSensorList(std::vector<BaseSensor*> &memory, std::string stringSource
             logMessage("\t(*)Detected known sensor type:%s, sensor with ID:%s added!\n", sensor->Type.c_str(), sensor->UID.c_str());
         }
     }
+    logMessage("\t(i)Added %d sensors...\n", static_cast<int>(memory.size()));
 }
 
 BaseSensor* createSensorByType(std::string type, std::string uid)
@@ -0,0 +1,124 @@
+/**
+ * @file sensor_health.hpp
+ * @brief Reply deadlines, backoff and offline detection of one sensor.
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#ifndef SENSOR_HEALTH_HPP
+#define SENSOR_HEALTH_HPP
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "config.hpp" ///< Configuration.
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @class SensorHealth
+ * @brief Tracks whether a sensor replies and when it may be requested again.
+ *
+ * Every timed out request doubles the wait before the next one, from the reply deadline
+ * up to SENSOR_BACKOFF_MAX, so an unplugged sensor is probed at a reduced rate and
+ * costs the loop nothing in between. SENSOR_OFFLINE_FAILURES timeouts in a row make the
+ * sensor offline, any reply makes it responsive again.
+ *
+ * Times are getTimeMs() values, compared by their unsigned difference only.
+ */
+class SensorHealth
+{
+public:
+    SensorHealth() : Failures(0), RetryMs(0), BackoffMs(0), SeenMs(0), Probing(false) {}
+
+    /**
+     * @brief Start the silence deadline, e.g. when the sensor is created.
+     */
+    void reset(unsigned long now)
+    {
+        Failures = 0;
+        BackoffMs = 0;
+        SeenMs = now;
+        Probing = false;
+    }
+
+    /**
+     * @brief Check if the sensor may be requested, it is not backing off.
+     */
+    bool due(unsigned long now) const { return BackoffMs == 0 || now - RetryMs >= BackoffMs; }
+
+    /**
+     * @brief Check if the sensor was silent for the given time.
+     */
+    bool silent(unsigned long now, unsigned long timeout) const { return now - SeenMs >= timeout; }
+
+    /**
+     * @brief Record a reply or update frame of the sensor.
+     *
+     * @return true if the sensor was offline.
+     */
+    bool replied(unsigned long now)
+    {
+        bool offline = isOffline();
+        Failures = 0;
+        BackoffMs = 0;
+        SeenMs = now;
+        Probing = false;
+        return offline;
+    }
+
+    /**
+     * @brief Record a request of the sensor which timed out.
+     *
+     * @param now The time of the timeout.
+     * @param timeout The reply deadline of the sensor, the first backoff.
+     * @return true if the sensor just became offline.
+     */
+    bool timedOut(unsigned long now, unsigned long timeout)
+    {
+        Probing = false;
+        RetryMs = now;
+        BackoffMs = BackoffMs == 0 ? timeout : BackoffMs * 2;
+        if (BackoffMs > SENSOR_BACKOFF_MAX) {
+            BackoffMs = SENSOR_BACKOFF_MAX;
+        }
+        return ++Failures == SENSOR_OFFLINE_FAILURES;
+    }
+
+    /**
+     * @brief Record a probe request of the sensor, sent because it was silent.
+     */
+    void probe() { Probing = true; }
+
+    /**
+     * @brief Check if a probe request of the sensor is outstanding.
+     */
+    bool probing() const { return Probing; }
+
+    /**
+     * @brief Check if the sensor stopped replying.
+     */
+    bool isOffline() const { return Failures >= SENSOR_OFFLINE_FAILURES; }
+
+    /**
+     * @brief Get number of timeouts in a row.
+     */
+    unsigned int failures() const { return Failures; }
+
+    /**
+     * @brief Get the wait before the next request [ms], 0 if not backing off.
+     */
+    unsigned long backoff() const { return BackoffMs; }
+
+private:
+    unsigned int Failures;  ///< Timeouts in a row.
+    unsigned long RetryMs;  ///< Time of the last timeout, the backoff runs from it.
+    unsigned long BackoffMs;///< Wait before the next request, 0 if not backing off.
+    unsigned long SeenMs;   ///< Time of the last reply or update frame.
+    bool Probing;           ///< Flag if a probe request of the sensor is outstanding.
+};
+
+#endif // SENSOR_HEALTH_HPP
@@ -0,0 +1,201 @@
+/**
+ * @file sensor_index.hpp
+ * @brief Constant-time lookup of sensors by UID.
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#ifndef SENSOR_INDEX_HPP
+#define SENSOR_INDEX_HPP
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+class BaseSensor;
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @class SensorIndex
+ * @brief Flat open-addressing hash table of sensors keyed by UID.
+ *
+ * UIDs are numeric as declared by ?INIT ("8:DHT11"), such UIDs are keyed by their value,
+ * so a lookup costs a short digit parse and usually one probe, no string hashing or
+ * comparing. Other UIDs are keyed by their FNV-1a hash and compared on match.
+ *
+ * The index keeps views of the UIDs, a sensor must stay alive with its UID unchanged
+ * while indexed. Of sensors with the same UID the first indexed one is found.
+ */
+class SensorIndex
+{
+public:
+    SensorIndex() : Slots(), Count(0), Shift(32) {}
+
+    /**
+     * @brief Add the sensor under its UID.
+     *
+     * @param uid The UID of the sensor.
+     * @param sensor The sensor.
+     * @return true if added, false if the UID is already indexed.
+     */
+    bool insert(std::string_view uid, BaseSensor *sensor)
+    {
+        if ((Count + 1) * 2 > Slots.size()) {
+            grow();
+        }
+        uint32_t key;
+        bool numeric = parseId(uid, key);
+        Slot *slot = &Slots[position(key)];
+        while (slot->Sensor) {
+            if (matches(*slot, uid, key, numeric)) {
+                return false;
+            }
+            slot = next(slot);
+        }
+        *slot = {uid, sensor, key, numeric};
+        ++Count;
+        return true;
+    }
+
+    /**
+     * @brief Find sensor by UID.
+     *
+     * @return The sensor, nullptr if not indexed.
+     */
+    BaseSensor *find(std::string_view uid) const
+    {
+        uint32_t key;
+        bool numeric = parseId(uid, key);
+        return lookup(uid, key, numeric);
+    }
+
+    /**
+     * @brief Find sensor by numeric UID (e.g. 8 for "8"), without formatting it.
+     *
+     * @return The sensor, nullptr if not indexed.
+     */
+    BaseSensor *find(uint32_t id) const
+    {
+        return id < NUMERIC_LIMIT ? lookup(std::string_view(), id, true) : nullptr;
+    }
+
+    /**
+     * @brief Remove all sensors.
+     */
+    void clear()
+    {
+        Slots.clear();
+        Count = 0;
+        Shift = 32;
+    }
+
+    /**
+     * @brief Get number of indexed sensors.
+     */
+    size_t size() const { return Count; }
+
+private:
+    static constexpr uint32_t NUMERIC_LIMIT = 1000000000; ///< Numeric keys have at most 9 digits.
+
+    /**
+     * @brief Table slot, free if Sensor is nullptr.
+     */
+    struct Slot
+    {
+        std::string_view Uid;          ///< UID of the sensor.
+        BaseSensor *Sensor = nullptr;  ///< Indexed sensor.
+        uint32_t Key = 0;              ///< UID value if numeric, else FNV-1a hash of the UID.
+        bool Numeric = false;          ///< Flag if the UID is numeric.
+    };
+
+    std::vector<Slot> Slots;  ///< Table, the size is zero or a power of two.
+    size_t Count;             ///< Number of indexed sensors.
+    unsigned Shift;           ///< 32 - log2 of the table size, keeps the high bits of the hash.
+
+    /**
+     * @brief Parse canonical decimal UID ("0", "8", "120"), else hash it.
+     *
+     * @return true if numeric, key is its value then.
+     */
+    static bool parseId(std::string_view uid, uint32_t &key)
+    {
+        if (!uid.empty() && uid.size() <= 9 && (uid[0] != '0' || uid.size() == 1)) {
+            uint32_t value = 0;
+            size_t i = 0;
+            for (; i < uid.size() && uid[i] >= '0' && uid[i] <= '9'; ++i) {
+                value = value * 10 + static_cast<uint32_t>(uid[i] - '0');
+            }
+            if (i == uid.size()) {
+                key = value;
+                return true;
+            }
+        }
+        key = 2166136261u;
+        for (char c : uid) {
+            key = (key ^ static_cast<uint8_t>(c)) * 16777619u;
+        }
+        return false;
+    }
+
+    static bool matches(const Slot &slot, std::string_view uid, uint32_t key, bool numeric)
+    {
+        return slot.Key == key && slot.Numeric == numeric && (numeric || slot.Uid == uid);
+    }
+
+    size_t position(uint32_t key) const
+    {
+        // Fibonacci hashing: the high bits of the product depend on all bits of the key,
+        // so sequential ids and ids differing only above the table size are spread.
+        return static_cast<uint32_t>(key * 2654435769u) >> Shift;
+    }
+
+    Slot *next(Slot *slot)
+    {
+        return ++slot == Slots.data() + Slots.size() ? Slots.data() : slot;
+    }
+
+    BaseSensor *lookup(std::string_view uid, uint32_t key, bool numeric) const
+    {
+        if (Count == 0) {
+            return nullptr;
+        }
+        for (size_t i = position(key);; i = (i + 1) & (Slots.size() - 1)) {
+            const Slot &slot = Slots[i];
+            if (!slot.Sensor) {
+                return nullptr;
+            }
+            if (matches(slot, uid, key, numeric)) {
+                return slot.Sensor;
+            }
+        }
+    }
+
+    void grow()
+    {
+        std::vector<Slot> old(Slots.size() < 16 ? 16 : Slots.size() * 2);
+        old.swap(Slots);
+        Shift = 32;
+        for (size_t size = Slots.size(); size > 1; size >>= 1) {
+            --Shift;
+        }
+        for (const Slot &slot : old) {
+            if (slot.Sensor) {
+                Slot *free = &Slots[position(slot.Key)];
+                while (free->Sensor) {
+                    free = next(free);
+                }
+                *free = slot;
+            }
+        }
+    }
+};
+
+#endif // SENSOR_INDEX_HPP
@@ -0,0 +1,217 @@
+/**
+ * @file sensor_schemas.hpp
+ * @brief Field schemas of the sensor classes.
+ *
+ * The schemas do not depend on the GUI, so they can be shared by the sensor classes
+ * and by the host-side fuzzing and benchmark targets.
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#ifndef SENSOR_SCHEMAS_HPP
+#define SENSOR_SCHEMAS_HPP
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "field_schema.hpp" ///< FieldSchema, DataType.
+
+#include <array>
+
+/**************************************************************************/
+// SCHEMAS
+/**************************************************************************/
+
+/**
+ * @brief Field schema of the ADC sensor.
+ */
+struct ADCSchema
+{
+    static constexpr std::array<FieldSchema, 1> Configs{{
+        {"resolution", "bits", DataType::INT, "12"},
+    }};
+    static constexpr std::array<FieldSchema, 1> Values{{
+        {"value", "", DataType::INT, "0"},
+    }};
+};
+
+/**
+ * @brief Field schema of the Joystick sensor.
+ */
+struct JoystickSchema
+{
+    static constexpr std::array<FieldSchema, 0> Configs{};
+    static constexpr std::array<FieldSchema, 3> Values{{
+        {"XCoordination", "%", DataType::INT, "50"},
+        {"YCoordination", "%", DataType::INT, "50"},
+        {"Button", "ON/OFF", DataType::INT, "0"},
+    }};
+};
+
+/**
+ * @brief Field schema of the DHT11 sensor.
+ */
+struct DHT11Schema
+{
+    static constexpr std::array<FieldSchema, 1> Configs{{
+        {"resolution", "digits", DataType::INT, "3"},
+    }};
+    static constexpr std::array<FieldSchema, 2> Values{{
+        {"Temperature", "°C", DataType::FLOAT, "0"},
+        {"Humidity", "%", DataType::INT, "0"},
+    }};
+};
+
+/**
+ * @brief Field schema of the LinearHallAndDigital sensor.
+ */
+struct LinearHallAndDigitalSchema
+{
+    static constexpr std::array<FieldSchema, 1> Configs{{
+        {"precision", "decimals", DataType::INT, "2"},
+    }};
+    static constexpr std::array<FieldSchema, 2> Values{{
+        {"milliTesla Meter", "milliTesla", DataType::FLOAT, "0"},
+        {"Magnet Detector", "", DataType::INT, "0"},
+    }};
+};
+
+/**
+ * @brief Field schema of the PhotoResistor sensor.
+ */
+struct PhotoResistorSchema
+{
+    static constexpr std::array<FieldSchema, 1> Configs{{
+        {"resolution", "digits", DataType::INT, "5"},
+    }};
+    static constexpr std::array<FieldSchema, 1> Values{{
+        {"Lux", "Lux", DataType::INT, "0"},
+    }};
+};
+
+/**
+ * @brief Field schema of the LinearHall sensor.
+ */
+struct LinearHallSchema
+{
+    static constexpr std::array<FieldSchema, 1> Configs{{
+        {"precision", "decimals", DataType::INT, "2"},
+    }};
+    static constexpr std::array<FieldSchema, 1> Values{{
+        {"milliTesla", "milliTesla", DataType::FLOAT, "0"},
+    }};
+};
+
+/**
+ * @brief Field schema of the DigitalTemperature sensor.
+ */
+struct DigitalTemperatureSchema
+{
+    static constexpr std::array<FieldSchema, 1> Configs{{
+        {"precision", "decimals", DataType::INT, "2"},
+    }};
+    static constexpr std::array<FieldSchema, 2> Values{{
+        {"Temperature", "°C", DataType::FLOAT, "0"},
+        {"Threshold", "", DataType::INT, "0"},
+    }};
+};
+
+/**
+ * @brief Field schema of the AnalogTemperature sensor.
+ */
+struct AnalogTemperatureSchema
+{
+    static constexpr std::array<FieldSchema, 1> Configs{{
+        {"precision", "decimals", DataType::INT, "2"},
+    }};
+    static constexpr std::array<FieldSchema, 1> Values{{
+        {"Temperature", "°C", DataType::FLOAT, "0"},
+    }};
+};
+
+/**
+ * @brief Field schema of the TH sensor.
+ */
+struct THSchema
+{
+    static constexpr std::array<FieldSchema, 1> Configs{{
+        {"precision", "decimals", DataType::INT, "2"},
+    }};
+    static constexpr std::array<FieldSchema, 2> Values{{
+        {"temperature", "Celsia", DataType::FLOAT, "0"},
+        {"humidity", "%", DataType::INT, "0"},
+    }};
+};
+
+/**
+ * @brief Field schema of the DigitalHall sensor.
+ */
+struct DigitalHallSchema
+{
+    static constexpr std::array<FieldSchema, 1> Configs{{
+        {"resolution", "bits", DataType::INT, "1"},
+    }};
+    static constexpr std::array<FieldSchema, 1> Values{{
+        {"Magnet Detector", "", DataType::INT, "0"},
+    }};
+};
+
+/**
+ * @brief Field schema of the PhotoInterrupter sensor.
+ */
+struct PhotoInterrupterSchema
+{
+    static constexpr std::array<FieldSchema, 0> Configs{};
+    static constexpr std::array<FieldSchema, 1> Values{{
+        {"Motion Detector", "", DataType::INT, "0"},
+    }};
+};
+
+/**
+ * @brief Field schema of the TP sensor.
+ */
+struct TPSchema
+{
+    static constexpr std::array<FieldSchema, 1> Configs{{
+        {"Precision", "decimals", DataType::INT, "2"},
+    }};
+    static constexpr std::array<FieldSchema, 2> Values{{
+        {"Temperature", "°C", DataType::FLOAT, "0"},
+        {"Pressure", "hPa", DataType::FLOAT, "0"},
+    }};
+};
+
+/**
+ * @brief Field schema of the GAT sensor.
+ */
+struct GATSchema
+{
+    static constexpr std::array<FieldSchema, 1> Configs{{
+        {"Precision", "decimals", DataType::INT, "2"},
+    }};
+    static constexpr std::array<FieldSchema, 7> Values{{
+        {"Temperature", "°C", DataType::FLOAT, "0"},
+        {"acm_x", "g", DataType::FLOAT, "0"},
+        {"acm_y", "g", DataType::FLOAT, "0"},
+        {"acm_z", "g", DataType::FLOAT, "0"},
+        {"gyr_x", "°/s", DataType::FLOAT, "0"},
+        {"gyr_y", "°/s", DataType::FLOAT, "0"},
+        {"gyr_z", "°/s", DataType::FLOAT, "0"},
+    }};
+};
+
+/**
+ * @brief Field schema of the TOF sensor.
+ */
+struct TOFSchema
+{
+    static constexpr std::array<FieldSchema, 1> Configs{{
+        {"Precision", "decimals", DataType::INT, "2"},
+    }};
+    static constexpr std::array<FieldSchema, 1> Values{{
+        {"dist", "mm", DataType::INT, "0"},
+    }};
+};
+
+#endif // SENSOR_SCHEMAS_HPP
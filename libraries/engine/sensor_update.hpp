@@ -0,0 +1,68 @@
+/**
+ * @file sensor_update.hpp
+ * @brief Typed sensor updates passed from the communication task to the UI.
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#ifndef SENSOR_UPDATE_HPP
+#define SENSOR_UPDATE_HPP
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "config.hpp"       ///< UPDATE_QUEUE_CAP.
+#include "field_schema.hpp" ///< NumericValue.
+#include "ring_buffer.hpp"  ///< RingBuffer.
+
+#include <cstdint>
+
+class BaseSensor;
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @enum UpdateKind
+ * @brief What a sensor update changes.
+ *
+ * - VALUE: Value at position Field of the values schema, Number holds it.
+ * - STATUS: Status reported by the device, Number.Int holds the SensorStatus.
+ * - ONLINE: The offline sensor replied again.
+ * - OFFLINE: The sensor stopped replying.
+ * - REJECTED: Number.Int values of a frame were rejected as malformed.
+ */
+enum class UpdateKind : uint8_t
+{
+    VALUE,
+    STATUS,
+    ONLINE,
+    OFFLINE,
+    REJECTED
+};
+
+/**
+ * @struct SensorUpdate
+ * @brief One change of a sensor, parsed by the communication task and applied by the UI.
+ *
+ * Trivially copyable, so it passes the lock-free queue by value and the UI thread is the
+ * only one touching the sensors. It holds numbers only, sensors with STRING values cannot
+ * run in threaded mode (see SensorManager::startThreaded).
+ */
+struct SensorUpdate
+{
+    BaseSensor *Sensor;      ///< Updated sensor.
+    UpdateKind Kind;         ///< What is updated.
+    uint8_t Field;           ///< Value position of VALUE update.
+    NumericValue Number;     ///< New value, status or count.
+    unsigned long ReceivedMs;///< Receive time of the frame (see getTimeMs).
+};
+
+/**
+ * @brief Queue of sensor updates, the communication task writes and the UI thread reads.
+ */
+typedef RingBuffer<SensorUpdate, UPDATE_QUEUE_CAP> UpdateQueue;
+
+#endif // SENSOR_UPDATE_HPP
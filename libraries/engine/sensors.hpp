@@ -14,6 +14,7 @@
  *      INCLUDES
  *********************/
 #include "base_sensor.hpp" ///< BaseSensor class.
+#include "sensor_schemas.hpp" ///< Sensor field schemas.
 
 /**************************************************************************/
 // SENSORS
@@ -26,7 +27,7 @@
  * Represents an Analog-to-Digital Converter (ADC) sensor. Implements initialization, configuration,
  * updating, and printing specific to ADC sensors.
  */
-class ADC : public BaseSensor
+class ADC : public SchemaSensor<ADCSchema>
 {
 public:
     /**
@@ -36,7 +37,7 @@ public:
      *
      * @param uid The unique sensor identifier.
      */
-    ADC(std::string uid) : BaseSensor(uid)
+    ADC(std::string uid) : SchemaSensor(uid)
     {
         init();
     }
@@ -60,18 +61,6 @@ public:
         Type = "ADC";
         Description = "Analog to Digital Converter";
         Error = nullptr;
-
-        try
-        {
-            // Default configs
-            addConfigParameter("resolution", {"12", "bits", DataType::INT, 0});
-            // Default values
-            addValueParameter("value", {"0", "", DataType::INT, 0});
-        }
-        catch (const std::exception &e)
-        {
-            throw;
-        }
     }
 
     /**
@@ -116,7 +105,7 @@ public:
  * Represents a Joystick as a peripheral constructed as sensor. Implements initialization, configuration,
  * updating, and printing specific to Joystick sensors.
  */
-class Joystick : public BaseSensor
+class Joystick : public SchemaSensor<JoystickSchema>
 {
 protected:
     // Container
@@ -135,7 +124,7 @@ public:
      *
      * @param uid The unique sensor identifier.
      */
-    Joystick(std::string uid) : BaseSensor(uid)
+    Joystick(std::string uid) : SchemaSensor(uid)
     {
         init();
     }
@@ -157,20 +146,7 @@ public:
         Type = "Joystick";
         Description = "Joystick peripheral";
         Error = nullptr;
-
-        try
-        {
-            // Default configs
-            // If there are no configs, you can skip this step
-            // Default values
-            addValueParameter("XCoordination", {"50", "%", DataType::INT, 0});
-            addValueParameter("YCoordination", {"50", "%", DataType::INT, 0});
-            addValueParameter("Button", {"0", "ON/OFF", DataType::INT, 0});
-        }
-        catch (const std::exception &e)
-        {
-            throw;
-        }
+        SamplePeriodMs = 20; // Follows the hand at 50 Hz.
     }
 
     /**
@@ -251,7 +227,7 @@ public:
  * Represents a DHT11 as a temperature and humidity sensor. Implements initialization, configuration,
  * updating, and printing specific to DHT11 sensors.
  */
-class DHT11 : public BaseSensor
+class DHT11 : public SchemaSensor<DHT11Schema>
 {
 protected:
     lv_obj_t *ui_Widget;
@@ -274,7 +250,7 @@ protected:
     lv_chart_series_t *ui_Chart_series_H;
 
 public:
-    DHT11(std::string uid) : BaseSensor(uid) { init(); }
+    DHT11(std::string uid) : SchemaSensor(uid) { init(); }
     virtual ~DHT11() {}
 
     virtual void init() override
@@ -282,10 +258,7 @@ public:
         Type = "DHT11";
         Description = "DHT11 Temperature & Humidity sensor";
         Error = nullptr;
-
-        addConfigParameter("resolution", {"3", "digits", DataType::INT, 0});
-        addValueParameter("Temperature", {"0", "°C", DataType::INT, 0});
-        addValueParameter("Humidity", {"0", "%", DataType::INT, 0});
+        SamplePeriodMs = 1000; // Measures once per second.
     }
 
     virtual void construct() override
@@ -512,6 +485,15 @@ public:
 
     void show() override { lv_obj_clear_flag(ui_Widget, LV_OBJ_FLAG_HIDDEN); }
     void hide() override { lv_obj_add_flag(ui_Widget, LV_OBJ_FLAG_HIDDEN); }
+    void destruct(bool deferred) override
+    {
+        if (deferred) {
+            lv_obj_del_async(ui_Widget);
+        } else {
+            lv_obj_del(ui_Widget);
+        }
+        ui_Widget = nullptr;
+    }
 };
 
 /**************************************************************************/
@@ -523,7 +505,7 @@ public:
  * Represents a Linear Hall sensor, which returns strenght of a magnet in milliTesla. Implements initialization, configuration,
  * updating, and printing specific to LinearHallAndDigital sensors.
  */
-class LinearHallAndDigital : public BaseSensor
+class LinearHallAndDigital : public SchemaSensor<LinearHallAndDigitalSchema>
 {
 protected:
     // Container
@@ -540,7 +522,7 @@ public:
      *
      * @param uid The unique sensor identifier.
      */
-    LinearHallAndDigital(std::string uid) : BaseSensor(uid)
+    LinearHallAndDigital(std::string uid) : SchemaSensor(uid)
     {
         init();
     }
@@ -562,19 +544,6 @@ public:
         Type = "LinearHallAndDigital";
         Description = "Returns milliTesla of a measured magnet and if he goes past linearity";
         Error = nullptr;
-
-        try
-        {
-            // Default configs
-            addConfigParameter("precision", {"2", "decimals", DataType::INT, 0});
-            // Default values
-            addValueParameter("milliTesla Meter", {"0", "milliTesla", DataType::FLOAT, 0});
-            addValueParameter("Magnet Detector", {"0", "", DataType::INT, 0});
-        }
-        catch (const std::exception &e)
-        {
-            throw;
-        }
     }
 
     /**
@@ -647,7 +616,7 @@ public:
  * Represents a PhotoResistor which measures lux in users environment. Implements initialization, configuration,
  * updating, and printing specific to PhotoResistor sensors.
  */
-class PhotoResistor : public BaseSensor
+class PhotoResistor : public SchemaSensor<PhotoResistorSchema>
 {
 protected:
     lv_obj_t *ui_Widget;
@@ -669,7 +638,7 @@ public:
      *
      * @param uid The unique sensor identifier.
      */
-    PhotoResistor(std::string uid) : BaseSensor(uid)
+    PhotoResistor(std::string uid) : SchemaSensor(uid)
     {
         init();
     }
@@ -691,18 +660,6 @@ public:
         Type = "PhotoResistor";
         Description = "Returns Lux of a measured environment, which users is in";
         Error = nullptr;
-
-        try
-        {
-            // Default configs
-            addConfigParameter("resolution", {"5", "digits", DataType::INT, 0});
-            // Default values
-            addValueParameter("Lux", {"0", "Lux", DataType::INT, 0});
-        }
-        catch (const std::exception &e)
-        {
-            throw;
-        }
     }
 
     /**
@@ -879,6 +836,15 @@ public:
 
     void show() override { lv_obj_clear_flag(ui_Widget, LV_OBJ_FLAG_HIDDEN); }
     void hide() override { lv_obj_add_flag(ui_Widget, LV_OBJ_FLAG_HIDDEN); }
+    void destruct(bool deferred) override
+    {
+        if (deferred) {
+            lv_obj_del_async(ui_Widget);
+        } else {
+            lv_obj_del(ui_Widget);
+        }
+        ui_Widget = nullptr;
+    }
 };
 
 /**************************************************************************/
@@ -890,7 +856,7 @@ public:
  * Represents a Linear Hall sensor, which returns strenght of a magnet in gauss. Implements initialization, configuration,
  * updating, and printing specific to LinearHall sensors.
  */
-class LinearHall : public BaseSensor
+class LinearHall : public SchemaSensor<LinearHallSchema>
 {
 protected:
 lv_obj_t *ui_Widget;
@@ -912,7 +878,7 @@ public:
      *
      * @param uid The unique sensor identifier.
      */
-    LinearHall(std::string uid) : BaseSensor(uid)
+    LinearHall(std::string uid) : SchemaSensor(uid)
     {
         init();
     }
@@ -935,18 +901,6 @@ public:
         Type = "LinearHall";
         Description = "Returns milliTesla of a measured magnet";
         Error = nullptr;
-
-        try
-        {
-            // Default configs
-            addConfigParameter("precision", {"2", "decimals", DataType::INT, 0});
-            // Default values
-            addValueParameter("milliTesla", {"0", "milliTesla", DataType::FLOAT, 0});
-        }
-        catch (const std::exception &e)
-        {
-            throw;
-        }
     }
 
     /**
@@ -1104,6 +1058,15 @@ lv_obj_set_style_text_font(ui_LabelSingleValueDesc, &lv_font_montserrat_20, LV_P
 
     void show() override { lv_obj_clear_flag(ui_Widget, LV_OBJ_FLAG_HIDDEN); }
     void hide() override { lv_obj_add_flag(ui_Widget, LV_OBJ_FLAG_HIDDEN); }
+    void destruct(bool deferred) override
+    {
+        if (deferred) {
+            lv_obj_del_async(ui_Widget);
+        } else {
+            lv_obj_del(ui_Widget);
+        }
+        ui_Widget = nullptr;
+    }
 };
 
 /**************************************************************************/
@@ -1115,7 +1078,7 @@ lv_obj_set_style_text_font(ui_LabelSingleValueDesc, &lv_font_montserrat_20, LV_P
  * Represents a Temperature sensor, which returns °C and ON/OFF if the temperature goes past hardware-configured value. Implements initialization, configuration,
  * updating, and printing specific to DigitalTemperature sensors.
  */
-class DigitalTemperature : public BaseSensor
+class DigitalTemperature : public SchemaSensor<DigitalTemperatureSchema>
 {
 protected:
     lv_obj_t *ui_Widget;
@@ -1130,7 +1093,7 @@ public:
      *
      * @param uid The unique sensor identifier.
      */
-    DigitalTemperature(std::string uid) : BaseSensor(uid)
+    DigitalTemperature(std::string uid) : SchemaSensor(uid)
     {
         init();
     }
@@ -1152,19 +1115,6 @@ public:
         Type = "DigitalTemperature";
         Description = "Returns temperature in °C and if the temperature goes past a hardware-configured value";
         Error = nullptr;
-
-        try
-        {
-            // Default configs
-            addConfigParameter("precision", {"2", "decimals", DataType::INT, 0});
-            // Default values
-            addValueParameter("Temperature", {"0", "°C", DataType::FLOAT, 0});
-            addValueParameter("Threshold", {"0", "", DataType::INT, 0});
-        }
-        catch (const std::exception &e)
-        {
-            throw;
-        }
     }
 
     /**
@@ -1237,7 +1187,7 @@ public:
  * Represents a Temperature sensor, which returns °C. Implements initialization, configuration,
  * updating, and printing specific to AnalogTemperature sensors.
  */
-class AnalogTemperature : public BaseSensor
+class AnalogTemperature : public SchemaSensor<AnalogTemperatureSchema>
 {
 protected:
     lv_obj_t *ui_Widget;
@@ -1252,7 +1202,7 @@ public:
      *
      * @param uid The unique sensor identifier.
      */
-    AnalogTemperature(std::string uid) : BaseSensor(uid)
+    AnalogTemperature(std::string uid) : SchemaSensor(uid)
     {
         init();
     }
@@ -1274,18 +1224,6 @@ public:
         Type = "AnalogTemperature";
         Description = "Returns temperature in °C";
         Error = nullptr;
-
-        try
-        {
-            // Default configs
-            addConfigParameter("precision", {"2", "decimals", DataType::INT, 0});
-            // Default values
-            addValueParameter("Temperature", {"0", "°C", DataType::FLOAT, 0});
-        }
-        catch (const std::exception &e)
-        {
-            throw;
-        }
     }
 
     /**
@@ -1350,7 +1288,7 @@ public:
  * Represents a Temperature/Huminidy sensor. Implements initialization, configuration, updating, and printing
  * specific to Temperature/Huminidy sensors.
  */
-class TH : public BaseSensor
+class TH : public SchemaSensor<THSchema>
 {
 public:
     /**
@@ -1360,7 +1298,7 @@ public:
      *
      * @param uid The unique sensor identifier.
      */
-    TH(std::string uid) : BaseSensor(uid)
+    TH(std::string uid) : SchemaSensor(uid)
     {
         init();
     }
@@ -1383,19 +1321,7 @@ public:
         Type = "TH";
         Description = "Temperature & Humidity Sensor";
         Error = nullptr;
-
-        try
-        {
-            // Default configs
-            addConfigParameter("precision", {"2", "decimals", DataType::INT, 0});
-            // Default values
-            addValueParameter("temperature", {"0", "Celsia", DataType::FLOAT, 0});
-            addValueParameter("humidity", {"0", "%", DataType::INT, 0});
-        }
-        catch (const std::exception &e)
-        {
-            throw;
-        }
+        SamplePeriodMs = 1000;
     }
 
     /**
@@ -1439,7 +1365,7 @@ public:
  * Represents a Linear Hall sensor, which returns 1 if it in a presence of a magnet. Implements initialization, configuration,
  * updating, and printing specific to DigitalHall sensors.
  */
-class DigitalHall : public BaseSensor
+class DigitalHall : public SchemaSensor<DigitalHallSchema>
 {
 protected:
     lv_obj_t *ui_Widget;
@@ -1453,7 +1379,7 @@ public:
      *
      * @param uid The unique sensor identifier.
      */
-    DigitalHall(std::string uid) : BaseSensor(uid)
+    DigitalHall(std::string uid) : SchemaSensor(uid)
     {
         init();
     }
@@ -1476,18 +1402,6 @@ public:
         Type = "DigitalHall";
         Description = "Returns 1 of a measured magnet and if he goes past linearity";
         Error = nullptr;
-
-        try
-        {
-            // Default configs
-            addConfigParameter("resolution", {"1", "bits", DataType::INT, 0});
-            // Default values
-            addValueParameter("Magnet Detector", {"0", "", DataType::INT, 0});
-        }
-        catch (const std::exception &e)
-        {
-            throw;
-        }
     }
 
     /**
@@ -1552,7 +1466,7 @@ public:
  * Represents a PhotoInterrupter, which returns 1 if something breaks line between IR light. Implements initialization, configuration,
  * updating, and printing specific to PhotoInterrupter sensors.
  */
-class PhotoInterrupter : public BaseSensor
+class PhotoInterrupter : public SchemaSensor<PhotoInterrupterSchema>
 {
 protected:
     lv_obj_t *ui_Widget;
@@ -1566,7 +1480,7 @@ public:
      *
      * @param uid The unique sensor identifier.
      */
-    PhotoInterrupter(std::string uid) : BaseSensor(uid)
+    PhotoInterrupter(std::string uid) : SchemaSensor(uid)
     {
         init();
     }
@@ -1589,16 +1503,6 @@ public:
         Type = "PhotoInterrupter";
         Description = "Returns 1 of a measured magnet and if he goes past linearity";
         Error = nullptr;
-
-        try
-        {
-            // Default values
-            addValueParameter("Motion Detector", {"0", "", DataType::INT, 0});
-        }
-        catch (const std::exception &e)
-        {
-            throw;
-        }
     }
 
     /**
@@ -1666,7 +1570,7 @@ public:
  * specific to Temperature/Pressure sensors.
  */
 
-class TP : public BaseSensor
+class TP : public SchemaSensor<TPSchema>
 {
 public:
     /**
@@ -1676,7 +1580,7 @@ public:
      *
      * @param uid The unique sensor identifier.
      */
-    TP(std::string uid) : BaseSensor(uid)
+    TP(std::string uid) : SchemaSensor(uid)
     {
         init();
     }
@@ -1708,19 +1612,6 @@ public:
         Type = "TP";
         Description = "Temperature & Pressure Sensor";
         Error = nullptr;
-
-        try
-        {
-            // Default configs
-            addConfigParameter("Precision", {"2", "decimals", DataType::INT, 0});
-            // Default values
-            addValueParameter("Temperature", {"0", "°C", DataType::FLOAT, 0});
-            addValueParameter("Pressure", {"0", "hPa", DataType::FLOAT, 0});
-        }
-        catch (const std::exception &e)
-        {
-            throw;
-        }
     }
 
     /**
@@ -1827,7 +1718,7 @@ public:
  * specific to Gyroscope/Accelerometr/Temperature sensors.
  */
 
-class GAT : public BaseSensor
+class GAT : public SchemaSensor<GATSchema>
 {
 public:
     /**
@@ -1837,7 +1728,7 @@ public:
      *
      * @param uid The unique sensor identifier.
      */
-    GAT(std::string uid) : BaseSensor(uid)
+    GAT(std::string uid) : SchemaSensor(uid)
     {
         init();
     }
@@ -1872,24 +1763,6 @@ public:
         Type = "GAT";
         Description = "Gyroscope/Accelerometr/Temperature sensor";
         Error = nullptr;
-
-        try
-        {
-            // Default configs
-            addConfigParameter("Precision", {"2", "decimals", DataType::INT, 0});
-            // Default values
-            addValueParameter("Temperature", {"0", "°C", DataType::FLOAT, 0});
-            addValueParameter("acm_x", {"0", "g", DataType::FLOAT, 0});
-            addValueParameter("acm_y", {"0", "g", DataType::FLOAT, 0});
-            addValueParameter("acm_z", {"0", "g", DataType::FLOAT, 0});
-            addValueParameter("gyr_x", {"0", "°/s", DataType::FLOAT, 0});
-            addValueParameter("gyr_y", {"0", "°/s", DataType::FLOAT, 0});
-            addValueParameter("gyr_z", {"0", "°/s", DataType::FLOAT, 0});
-        }
-        catch (const std::exception &e)
-        {
-            throw;
-        }
     }
 
     /**
@@ -2018,7 +1891,7 @@ public:
  * specific to Time of flight sensors.
  */
 
-class TOF : public BaseSensor
+class TOF : public SchemaSensor<TOFSchema>
 {
 public:
     /**
@@ -2028,7 +1901,7 @@ public:
      *
      * @param uid The unique sensor identifier.
      */
-    TOF(std::string uid) : BaseSensor(uid)
+    TOF(std::string uid) : SchemaSensor(uid)
     {
         init();
     }
@@ -2056,18 +1929,6 @@ public:
         Type = "TOF";
         Description = "Time of flight sensor";
         Error = nullptr;
-
-        try
-        {
-            // Default configs
-            addConfigParameter("Precision", {"2", "decimals", DataType::INT, 0});
-            // Default values
-            addValueParameter("dist", {"0", "mm", DataType::INT, 0});
-        }
-        catch (const std::exception &e)
-        {
-            throw;
-        }
     }
 
     /**
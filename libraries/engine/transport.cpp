@@ -0,0 +1,312 @@
+/**
+ * @file transport.cpp
+ * @brief Definition of the byte transports used by the messenger.
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "transport.hpp"
+
+#ifdef ARDUINO_H
+    #include <Arduino.h>  ///< Include Arduino
+#endif
+
+#ifdef STDIO_H
+    #include <chrono>
+    #include <cstdio>
+    #include <thread>
+#endif
+
+#ifdef POSIX_TRANSPORTS
+    #include <cerrno>
+    #include <cstdlib>
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <termios.h>
+    #include <unistd.h>
+#endif
+
+/**************************************************************************/
+// SERIAL
+/**************************************************************************/
+
+#ifdef ARDUINO_H
+SerialTransport::SerialTransport(HardwareSerial &port, unsigned long baudrate, uint32_t mode, int tx, int rx)
+ : Port(port), Baudrate(baudrate), Mode(mode), Tx(tx), Rx(rx), Started(false), Received(), Dropped(0)
+{
+}
+
+void SerialTransport::configure(unsigned long baudrate, uint32_t mode, int tx, int rx)
+{
+    Baudrate = baudrate;
+    Mode = mode;
+    Tx = tx;
+    Rx = rx;
+    Started = false;
+}
+
+bool SerialTransport::begin()
+{
+    if (Started) {
+        return true;
+    }
+    Port.begin(Baudrate, Mode, Tx, Rx);
+    while(!Port);
+    Port.onReceive([this]() { onReceive(); });
+    Started = true;
+    return true;
+}
+
+void SerialTransport::onReceive()
+{
+    // Runs in the UART event task, move all available bytes to the ring buffer.
+    char chunk[64];
+    size_t count = 0;
+    while (Port.available() > 0) {
+        chunk[count++] = static_cast<char>(Port.read());
+        if (count == sizeof(chunk)) {
+            Dropped.fetch_add(count - Received.write(chunk, count), std::memory_order_relaxed);
+            count = 0;
+        }
+    }
+    Dropped.fetch_add(count - Received.write(chunk, count), std::memory_order_relaxed);
+}
+
+size_t SerialTransport::send(const char *data, size_t size)
+{
+    return countSent(size, Port.write(reinterpret_cast<const uint8_t*>(data), size));
+}
+
+size_t SerialTransport::receive(char *data, size_t size)
+{
+    size_t count = Received.read(data, size);
+    Stats.BytesReceived += count;
+    return count;
+}
+
+void SerialTransport::flush()
+{
+    Port.flush();
+}
+
+TransportStats SerialTransport::stats() const
+{
+    TransportStats stats = Stats;
+    stats.DroppedBytes = Dropped.load(std::memory_order_relaxed);
+    return stats;
+}
+
+StreamTransport::StreamTransport(Stream &port)
+ : Port(port)
+{
+}
+
+size_t StreamTransport::send(const char *data, size_t size)
+{
+    return countSent(size, Port.write(reinterpret_cast<const uint8_t*>(data), size));
+}
+
+size_t StreamTransport::receive(char *data, size_t size)
+{
+    size_t count = 0;
+    while (count < size && Port.available() > 0) {
+        data[count++] = static_cast<char>(Port.read());
+    }
+    Stats.BytesReceived += count;
+    return count;
+}
+
+void StreamTransport::flush()
+{
+    Port.flush();
+}
+
+HardwareSerial UART1(UART1_PORT);
+
+Transport &getDefaultTransport()
+{
+    static SerialTransport transport(UART1);
+    return transport;
+}
+#endif
+
+/**************************************************************************/
+// STANDARD INPUT/OUTPUT
+/**************************************************************************/
+
+#ifdef STDIO_H
+bool StdioTransport::begin()
+{
+    if (Started) {
+        return true;
+    }
+    std::thread([this]() {
+        int c;
+        while ((c = getchar()) != EOF) {
+            char byte = static_cast<char>(c);
+            // Standard input can wait, unlike the UART, so nothing is dropped here.
+            while (Received.write(&byte, 1) == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }).detach();
+    Started = true;
+    return true;
+}
+
+size_t StdioTransport::send(const char *data, size_t size)
+{
+    size_t sent = fwrite(data, 1, size, stdout);
+    fflush(stdout); // Hand the bytes to the pipe, stdout is buffered.
+    return countSent(size, sent);
+}
+
+size_t StdioTransport::receive(char *data, size_t size)
+{
+    size_t count = Received.read(data, size);
+    Stats.BytesReceived += count;
+    return count;
+}
+
+void StdioTransport::flush()
+{
+    fflush(stdout);
+}
+
+Transport &getDefaultTransport()
+{
+    static StdioTransport transport;
+    return transport;
+}
+#endif
+
+/**************************************************************************/
+// POSIX
+/**************************************************************************/
+
+#ifdef POSIX_TRANSPORTS
+FdTransport::FdTransport(int readFd, int writeFd, bool owned)
+ : ReadFd(readFd), WriteFd(writeFd), Owned(owned)
+{
+}
+
+FdTransport::~FdTransport()
+{
+    if (Owned) {
+        if (ReadFd >= 0) close(ReadFd);
+        if (WriteFd >= 0 && WriteFd != ReadFd) close(WriteFd);
+    }
+}
+
+bool FdTransport::begin()
+{
+    return ReadFd >= 0 && WriteFd >= 0;
+}
+
+size_t FdTransport::send(const char *data, size_t size)
+{
+    size_t sent = 0;
+    while (WriteFd >= 0 && sent < size) {
+        ssize_t count = write(WriteFd, data + sent, size - sent);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            break;
+        }
+        sent += static_cast<size_t>(count);
+    }
+    return countSent(size, sent);
+}
+
+size_t FdTransport::receive(char *data, size_t size)
+{
+    // Poll with zero timeout, so the descriptor itself may stay blocking.
+    struct pollfd request = {ReadFd, POLLIN, 0};
+    if (ReadFd < 0 || poll(&request, 1, 0) <= 0 || !(request.revents & POLLIN)) {
+        return 0;
+    }
+    ssize_t count = read(ReadFd, data, size);
+    if (count <= 0) {
+        return 0;
+    }
+    Stats.BytesReceived += static_cast<unsigned long>(count);
+    return static_cast<size_t>(count);
+}
+
+void FdTransport::flush()
+{
+    if (WriteFd >= 0 && isatty(WriteFd)) {
+        tcdrain(WriteFd);
+    }
+}
+
+PtyTransport::PtyTransport() : FdTransport(-1, -1, true), SlavePath(), SlaveFd(-1)
+{
+}
+
+PtyTransport::~PtyTransport()
+{
+    if (SlaveFd >= 0) {
+        close(SlaveFd);
+    }
+}
+
+bool PtyTransport::begin()
+{
+    if (ReadFd >= 0) {
+        return true;
+    }
+
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0 || !ptsname(master)) {
+        if (master >= 0) close(master);
+        return false;
+    }
+    SlavePath = ptsname(master);
+    SlaveFd = open(SlavePath.c_str(), O_RDWR | O_NOCTTY);
+
+    // Raw mode, bytes pass unchanged (no echo, no line editing, no CR/LF translation).
+    struct termios settings;
+    if (SlaveFd >= 0 && tcgetattr(SlaveFd, &settings) == 0) {
+        cfmakeraw(&settings);
+        tcsetattr(SlaveFd, TCSANOW, &settings);
+    }
+
+    ReadFd = master;
+    WriteFd = master;
+    return true;
+}
+
+SocketPairTransport::SocketPairTransport() : FdTransport(-1, -1, true), PeerFd(-1)
+{
+}
+
+SocketPairTransport::~SocketPairTransport()
+{
+    if (PeerFd >= 0) {
+        close(PeerFd);
+    }
+}
+
+bool SocketPairTransport::begin()
+{
+    if (ReadFd >= 0) {
+        return true;
+    }
+
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        return false;
+    }
+    ReadFd = fds[0];
+    WriteFd = fds[0];
+    PeerFd = fds[1];
+    return true;
+}
+#endif
@@ -0,0 +1,322 @@
+/**
+ * @file transport.hpp
+ * @brief Declaration of the byte transports used by the messenger.
+ *
+ * A transport moves raw bytes between the twin and the device, framing is left to the
+ * messenger. Receiving never blocks: bytes which arrived meanwhile are returned, or none.
+ *
+ * - SerialTransport: HardwareSerial with event-driven receive (Arduino).
+ * - StreamTransport: any Stream, e.g. USB-CDC, received bytes are queued by its driver (Arduino).
+ * - StdioTransport: standard input/output with a reader thread (host).
+ * - FdTransport: POSIX file descriptors, e.g. a serial device or a pipe (host).
+ * - PtyTransport: pseudo terminal, a simulated device opens its slave side (host).
+ * - SocketPairTransport: connected pair of sockets, the peer side is the device (host).
+ * - LoopbackTransport: in-memory pair of endpoints (any platform).
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#ifndef TRANSPORT_HPP
+#define TRANSPORT_HPP
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "config.hpp"      ///< Configuration.
+#include "ring_buffer.hpp" ///< RingBuffer.
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+#ifdef ARDUINO_H
+    #include <HardwareSerial.h> ///< Include Arduino Serial functions
+#endif
+
+#if defined(STDIO_H) && (defined(__unix__) || defined(__APPLE__))
+    #define POSIX_TRANSPORTS ///< File descriptor based transports are available.
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @struct TransportStats
+ * @brief Traffic counters of a transport.
+ */
+struct TransportStats
+{
+    unsigned long BytesSent = 0;     ///< Bytes accepted by the link.
+    unsigned long BytesReceived = 0; ///< Bytes handed to the messenger.
+    unsigned long DroppedBytes = 0;  ///< Received bytes lost on full receive buffer.
+    unsigned long SendErrors = 0;    ///< Bytes the link did not accept.
+};
+
+/**
+ * @class Transport
+ * @brief Interface of a byte transport.
+ */
+class Transport
+{
+public:
+    virtual ~Transport() {}
+
+    /**
+     * @brief Open the link, repeated calls are ignored.
+     *
+     * @return true if the link is open.
+     */
+    virtual bool begin() { return true; }
+
+    /**
+     * @brief Send bytes.
+     *
+     * @return The number of bytes accepted by the link.
+     */
+    virtual size_t send(const char *data, size_t size) = 0;
+
+    /**
+     * @brief Receive bytes which arrived meanwhile, never blocks.
+     *
+     * @param data The output buffer.
+     * @param size The output buffer size.
+     * @return The number of received bytes, 0 if none are available.
+     */
+    virtual size_t receive(char *data, size_t size) = 0;
+
+    /**
+     * @brief Wait until all sent bytes left.
+     */
+    virtual void flush() {}
+
+    /**
+     * @brief Get traffic counters.
+     */
+    virtual TransportStats stats() const { return Stats; }
+
+protected:
+    TransportStats Stats; ///< Traffic counters, updated by the polling side.
+
+    /**
+     * @brief Count result of a send.
+     */
+    size_t countSent(size_t requested, size_t sent)
+    {
+        Stats.BytesSent += sent;
+        Stats.SendErrors += requested - sent;
+        return sent;
+    }
+};
+
+/**
+ * @class LoopbackTransport
+ * @brief In-memory endpoint, bytes sent by one endpoint are received by its peer.
+ *
+ * Each endpoint may be used from its own thread, the receive buffer is a SPSC queue.
+ */
+class LoopbackTransport : public Transport
+{
+public:
+    LoopbackTransport() : Peer(nullptr), Dropped(0) {}
+
+    /**
+     * @brief Connect two endpoints with each other.
+     */
+    static void connect(LoopbackTransport &a, LoopbackTransport &b)
+    {
+        a.Peer = &b;
+        b.Peer = &a;
+    }
+
+    size_t send(const char *data, size_t size) override
+    {
+        if (!Peer) {
+            return countSent(size, 0);
+        }
+        size_t written = Peer->Rx.write(data, size);
+        Peer->Dropped.fetch_add(size - written, std::memory_order_relaxed);
+        return countSent(size, size);
+    }
+
+    size_t receive(char *data, size_t size) override
+    {
+        size_t count = Rx.read(data, size);
+        Stats.BytesReceived += count;
+        return count;
+    }
+
+    TransportStats stats() const override
+    {
+        TransportStats stats = Stats;
+        stats.DroppedBytes = Dropped.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    LoopbackTransport *Peer;                ///< Connected endpoint.
+    RingBuffer<char, UART_RX_BUFFER> Rx;    ///< Bytes sent by the peer.
+    std::atomic<unsigned long> Dropped;     ///< Bytes lost on full receive buffer.
+};
+
+#ifdef ARDUINO_H
+/**
+ * @class SerialTransport
+ * @brief HardwareSerial link, received bytes are queued by the UART event task.
+ */
+class SerialTransport : public Transport
+{
+public:
+    SerialTransport(HardwareSerial &port, unsigned long baudrate = UART1_BAUDRATE, uint32_t mode = SERIAL_8N1,
+                    int tx = UART1_TX, int rx = UART1_RX);
+
+    /**
+     * @brief Change line settings, applied by the next begin().
+     */
+    void configure(unsigned long baudrate, uint32_t mode, int tx, int rx);
+
+    bool begin() override;
+    size_t send(const char *data, size_t size) override;
+    size_t receive(char *data, size_t size) override;
+    void flush() override;
+    TransportStats stats() const override;
+
+private:
+    HardwareSerial &Port;                 ///< Serial port.
+    unsigned long Baudrate;               ///< Line baudrate.
+    uint32_t Mode;                        ///< Line mode.
+    int Tx;                               ///< Transmit pin.
+    int Rx;                               ///< Receive pin.
+    bool Started;                         ///< Flag if the port is open.
+    RingBuffer<char, UART_RX_BUFFER> Received; ///< Bytes queued by the UART event task.
+    std::atomic<unsigned long> Dropped;   ///< Bytes lost on full receive buffer.
+
+    void onReceive();
+};
+
+/**
+ * @class StreamTransport
+ * @brief Stream link (e.g. USB-CDC "Serial" of ESP32-S3), opened by the sketch.
+ *
+ * The stream driver queues received bytes itself, receive() only takes the available ones.
+ */
+class StreamTransport : public Transport
+{
+public:
+    explicit StreamTransport(Stream &port);
+
+    size_t send(const char *data, size_t size) override;
+    size_t receive(char *data, size_t size) override;
+    void flush() override;
+
+private:
+    Stream &Port; ///< Stream of the link.
+};
+#endif
+
+#ifdef STDIO_H
+/**
+ * @class StdioTransport
+ * @brief Standard input/output link, standard input is read by a background thread.
+ */
+class StdioTransport : public Transport
+{
+public:
+    StdioTransport() : Started(false) {}
+
+    bool begin() override;
+    size_t send(const char *data, size_t size) override;
+    size_t receive(char *data, size_t size) override;
+    void flush() override;
+
+private:
+    bool Started;                         ///< Flag if the reader thread runs.
+    RingBuffer<char, UART_RX_BUFFER> Received; ///< Bytes queued by the reader thread.
+};
+#endif
+
+#ifdef POSIX_TRANSPORTS
+/**
+ * @class FdTransport
+ * @brief Link over POSIX file descriptors (serial device, pipe, socket).
+ */
+class FdTransport : public Transport
+{
+public:
+    /**
+     * @param readFd The descriptor to read from.
+     * @param writeFd The descriptor to write to (may be the same).
+     * @param owned Flag if the descriptors are closed by the transport.
+     */
+    FdTransport(int readFd, int writeFd, bool owned = false);
+    ~FdTransport() override;
+
+    FdTransport(const FdTransport&) = delete;
+    FdTransport& operator=(const FdTransport&) = delete;
+
+    bool begin() override;
+    size_t send(const char *data, size_t size) override;
+    size_t receive(char *data, size_t size) override;
+    void flush() override;
+
+protected:
+    int ReadFd;  ///< Descriptor to read from.
+    int WriteFd; ///< Descriptor to write to.
+    bool Owned;  ///< Flag if the descriptors are closed by the transport.
+};
+
+/**
+ * @class PtyTransport
+ * @brief Master side of a raw pseudo terminal, a simulated device opens slavePath().
+ */
+class PtyTransport : public FdTransport
+{
+public:
+    PtyTransport();
+    ~PtyTransport() override;
+
+    bool begin() override;
+
+    /**
+     * @brief Get path of the slave side (e.g. "/dev/pts/3"), empty if opening failed.
+     */
+    const std::string &slavePath() const { return SlavePath; }
+
+private:
+    std::string SlavePath; ///< Path of the slave side.
+    int SlaveFd;           ///< Slave side kept open, so the master never reads end of file.
+};
+
+/**
+ * @class SocketPairTransport
+ * @brief One side of a connected socket pair, the other side belongs to the device.
+ */
+class SocketPairTransport : public FdTransport
+{
+public:
+    SocketPairTransport();
+    ~SocketPairTransport() override;
+
+    bool begin() override;
+
+    /**
+     * @brief Get descriptor of the device side, owned by this transport (-1 if opening failed).
+     */
+    int peerFd() const { return PeerFd; }
+
+private:
+    int PeerFd; ///< Descriptor of the device side.
+};
+#endif
+
+/*********************
+ *      DECLARES
+ *********************/
+
+/**
+ * @brief Get transport of the platform: UART1 on Arduino, standard input/output on host.
+ */
+Transport &getDefaultTransport();
+
+#endif // TRANSPORT_HPP
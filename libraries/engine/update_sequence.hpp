@@ -0,0 +1,67 @@
+/**
+ * @file update_sequence.hpp
+ * @brief Sequence numbers of received update batches, for the delta frames.
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#ifndef UPDATE_SEQUENCE_HPP
+#define UPDATE_SEQUENCE_HPP
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * @class UpdateSequence
+ * @brief Tracks the last applied update batch of a bus, acknowledged by ?UPDATE&ack=N.
+ *
+ * A device supporting delta frames numbers every batch it sends in reply to ?UPDATE, of
+ * all or of listed sensors (seq=N), and answers a request acknowledging its last batch by
+ * the fields changed since (a delta), any other request by all fields. A delta is thus
+ * valid only right after the acknowledged batch, otherwise changes were lost and the
+ * acknowledgement is dropped, so the next request asks for the full update. Frames without
+ * sequence number (pushes, replies to numbered requests, devices without delta support)
+ * carry all fields of their sensor, which the device then no longer compares to, so they
+ * leave the sequence as it is.
+ */
+class UpdateSequence
+{
+public:
+    UpdateSequence() : Acked(-1) {}
+
+    /**
+     * @brief Drop the acknowledgement, the next request asks for the full update.
+     */
+    void reset() { Acked = -1; }
+
+    /**
+     * @brief Get sequence number to acknowledge, -1 if there is none.
+     */
+    long acked() const { return Acked; }
+
+    /**
+     * @brief Record the received batch of update frames.
+     *
+     * @param seq The sequence number of the batch, -1 if it has none.
+     * @return false on a sequence gap, the acknowledgement is dropped.
+     */
+    bool received(long seq)
+    {
+        if (seq < 0) {
+            return true; // Full frames only, the next delta still follows the acknowledged batch.
+        }
+        if (Acked >= 0 && seq != Acked + 1) {
+            Acked = -1;
+            return false;
+        }
+        Acked = seq;
+        return true;
+    }
+
+private:
+    long Acked; ///< Sequence number of the last applied batch, -1 requests full update.
+};
+
+#endif // UPDATE_SEQUENCE_HPP
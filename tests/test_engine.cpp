@@ -0,0 +1,317 @@
+/**
+ * @file test_engine.cpp
+ * @brief Host checks of the engine helpers and of the receive path.
+ *
+ * Every check prints its name and fails the run when the result differs from the expected one.
+ *
+ * Build and run on host (from the repository root):
+ *   g++ -std=c++17 -O1 -fsanitize=address,undefined -DSTDIO_H -DLV_CONF_INCLUDE_SIMPLE -Ilibraries \
+ *       -Ilibraries/lvgl -Ilibraries/engine -Ibenchmarks tests/test_engine.cpp \
+ *       libraries/engine/base_sensor.cpp libraries/engine/coalescer.cpp libraries/engine/exceptions.cpp \
+ *       libraries/engine/frame_check.cpp libraries/engine/helpers.cpp libraries/engine/logs.cpp \
+ *       libraries/engine/messenger.cpp libraries/engine/parser.cpp \
+ *       libraries/engine/transport.cpp -o test_engine
+ *   ./test_engine
+ *
+ * @copyright 2025 MTA
+ * @author Ing. Jiri Konecny
+ */
+
+#include "headless_sensor.hpp"
+#include "frame_check.hpp"
+#include "helpers.hpp"
+#include "sample_scheduler.hpp"
+#include "sensor_index.hpp"
+#include "update_sequence.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <initializer_list>
+#include <vector>
+
+static int failures = 0;
+
+/**
+ * @brief Report the check, count it as failed when the condition does not hold.
+ */
+static void check(const char *name, bool condition) {
+    printf("%-56s %s\n", name, condition ? "ok" : "FAILED");
+    if(!condition) {
+        ++failures;
+    }
+}
+
+/**
+ * @brief Format the value as formatNumber() does and compare with printf "%.*f".
+ */
+static bool formatsLikePrintf(double value, int decimals) {
+    char buffer[64];
+    char expected[64];
+    size_t length = formatNumber(buffer, sizeof(buffer), value, decimals);
+    snprintf(expected, sizeof(expected), "%.*f", decimals, value);
+    return length == strlen(expected) && strcmp(buffer, expected) == 0;
+}
+
+static void testFormatNumber() {
+    check("formatNumber 27.4 with 1 decimal", formatsLikePrintf(27.4, 1));
+    check("formatNumber -0.57 with 2 decimals", formatsLikePrintf(-0.57, 2));
+    check("formatNumber 1e14 with 6 decimals", formatsLikePrintf(1e14, 6));
+    check("formatNumber 2e10 with 9 decimals", formatsLikePrintf(2e10, 9));
+    check("formatNumber -9.3e9 with 9 decimals", formatsLikePrintf(-9.3e9, 9));
+    check("formatNumber 1e20 with 3 decimals", formatsLikePrintf(1e20, 3));
+}
+
+/**
+ * @brief Apply the batch and record its sequence number, as BusShard::ingest() does.
+ */
+static bool receiveBatch(std::vector<BaseSensor*> &sensors, UpdateSequence &sequence, std::string_view batch) {
+    long seq = -1;
+    forEachWireFrame(batch, WireFormat::TEXT, [&seq](std::string_view frame, WireFormat) {
+        SensorMetadata metadata = ParseMetadata(frame, true);
+        if(metadata.Seq >= 0) {
+            seq = metadata.Seq;
+        }
+    });
+    ingestFrames(sensors, batch, WireFormat::TEXT, true);
+    return sequence.received(seq);
+}
+
+static void testDeltaFrames() {
+    std::vector<BaseSensor*> sensors;
+    createHeadlessSensorList(sensors);
+    BaseSensor *dht = sensors[4];
+    UpdateSequence sequence;
+
+    check("delta full update accepted",
+          receiveBatch(sensors, sequence, "?id=8&seq=1&Temperature=22.5&Humidity=40") && sequence.acked() == 1);
+
+    check("delta partial frame accepted",
+          receiveBatch(sensors, sequence, "?id=8&seq=2&Humidity=41") && sequence.acked() == 2);
+    check("delta partial frame keeps missing fields",
+          dht->getValue<float>("Temperature") == 22.5f && dht->getValue<int>("Humidity") == 41);
+
+    check("delta unchanged batch accepted", receiveBatch(sensors, sequence, "?seq=3") && sequence.acked() == 3);
+
+    check("delta gap detected", !receiveBatch(sensors, sequence, "?id=8&seq=5&Humidity=43"));
+    check("delta gap requests full update", sequence.acked() == -1);
+
+    check("delta full update after gap accepted",
+          receiveBatch(sensors, sequence, "?id=8&seq=6&Temperature=23&Humidity=44") && sequence.acked() == 6);
+    check("delta recovered values",
+          dht->getValue<float>("Temperature") == 23.0f && dht->getValue<int>("Humidity") == 44);
+    check("delta partial frame after recovery accepted",
+          receiveBatch(sensors, sequence, "?id=8&seq=7&Temperature=23.5") && sequence.acked() == 7);
+
+    check("full frame without sequence keeps ack",
+          receiveBatch(sensors, sequence, "?id=8&Temperature=24&Humidity=45") && sequence.acked() == 7);
+
+    for(BaseSensor *sensor : sensors) {
+        delete sensor;
+    }
+}
+
+static void testDeltaListedRequests() {
+    std::vector<BaseSensor*> sensors;
+    createHeadlessSensorList(sensors);
+    BaseSensor *dht = sensors[4];
+    BaseSensor *light = sensors[6];
+    UpdateSequence sequence;
+
+    // ?UPDATE, ?UPDATE&id=8&ack=1, ?UPDATE&ack=2, ?UPDATE&id=10&ack=3: every reply is numbered.
+    check("delta full request accepted",
+          receiveBatch(sensors, sequence, "?id=8&seq=1&Temperature=22.5&Humidity=40?id=10&seq=1&Lux=80") &&
+          sequence.acked() == 1);
+    check("delta listed reply accepted",
+          receiveBatch(sensors, sequence, "?id=8&seq=2&Humidity=41") && sequence.acked() == 2);
+    check("delta full request after listed accepted",
+          receiveBatch(sensors, sequence, "?id=8&seq=3&Temperature=23?id=10&seq=3&Lux=90") &&
+          sequence.acked() == 3);
+    check("delta listed reply unchanged accepted", receiveBatch(sensors, sequence, "?seq=4") && sequence.acked() == 4);
+    check("delta mixed requests values",
+          dht->getValue<float>("Temperature") == 23.0f && dht->getValue<int>("Humidity") == 41 &&
+          light->getValue<int>("Lux") == 90);
+
+    // A push between the replies is sent in full, the next listed reply still follows the ack.
+    check("delta push between replies keeps ack",
+          receiveBatch(sensors, sequence, "?id=10&Lux=95") && sequence.acked() == 4);
+    check("delta listed reply after push accepted",
+          receiveBatch(sensors, sequence, "?id=10&seq=5&Lux=96") && sequence.acked() == 5);
+
+    check("delta lost listed reply detected", !receiveBatch(sensors, sequence, "?id=8&seq=7&Humidity=42"));
+    check("delta lost listed reply requests full update", sequence.acked() == -1);
+
+    for(BaseSensor *sensor : sensors) {
+        delete sensor;
+    }
+}
+
+static void testRepeatedKeys() {
+    std::vector<BaseSensor*> sensors;
+    createHeadlessSensorList(sensors);
+    BaseSensor *dht = sensors[4];
+    const char *frame = "?id=8&Humidity=40&Humidity=41";
+
+    ingestFrames(sensors, frame, WireFormat::TEXT, true);
+    check("repeated key first wins, applied at once", dht->getValue<int>("Humidity") == 40);
+
+    ingestFrames(sensors, "?id=8&Humidity=50", WireFormat::TEXT, true);
+    UpdateCoalescer coalescer;
+    coalescer.setEnabled(true);
+    ingestFrames(sensors, frame, WireFormat::TEXT, true, &coalescer);
+    coalescer.flush();
+    check("repeated key first wins, coalesced", dht->getValue<int>("Humidity") == 40);
+
+    int emitted = 0;
+    int value = 0;
+    dht->parseValues(std::string_view(frame).substr(6), WireFormat::TEXT, [&](size_t, const NumericValue &number) {
+        ++emitted;
+        value = number.Int;
+    });
+    check("repeated key first wins, parsed for the queue", emitted == 1 && value == 40);
+
+    for(BaseSensor *sensor : sensors) {
+        delete sensor;
+    }
+}
+
+static void testFrameSplitting() {
+    const char *batch = "?id=8&status=Error!&Humidity=40?id=10&Lux Meter=80";
+    size_t text = 0;
+    size_t frames = forEachWireFrame(batch, WireFormat::TEXT, [&text](std::string_view, WireFormat format) {
+        text += format == WireFormat::TEXT;
+    });
+    check("text link keeps '!' inside the frame", frames == 2 && text == 2);
+
+    std::string binary = "?id=8&Humidity=40";
+    binary += BINARY_FRAME_MARKER;
+    binary += static_cast<char>(2);
+    binary += "10";
+    size_t binaries = 0;
+    frames = forEachWireFrame(binary, WireFormat::BINARY, [&binaries](std::string_view, WireFormat format) {
+        binaries += format == WireFormat::BINARY;
+    });
+    check("binary link splits binary frames", frames == 2 && binaries == 1);
+}
+
+/**
+ * @brief Build the batch of checked frames, one envelope per seq.
+ */
+static std::string checkedBatch(std::initializer_list<uint8_t> seqs) {
+    std::string batch;
+    for(uint8_t seq : seqs) {
+        appendCheckedFrame(batch, "?id=8&Humidity=40", seq);
+    }
+    return batch;
+}
+
+static void testFrameCheck() {
+    auto count = [](std::string_view, WireFormat) {};
+
+    FrameChecker inOrder;
+    check("checked frames in order dispatched", inOrder.forEach(checkedBatch({254, 255, 0, 1}), WireFormat::TEXT, count) == 4);
+    check("checked frames in order nothing lost", inOrder.stats().Lost == 0);
+
+    FrameChecker gap;
+    check("checked frames with gap dispatched", gap.forEach(checkedBatch({1, 2, 5}), WireFormat::TEXT, count) == 3);
+    check("checked frames with gap lost counted", gap.stats().Lost == 2);
+
+    FrameChecker duplicate;
+    check("checked frame duplicate dropped", duplicate.forEach(checkedBatch({7, 7, 8}), WireFormat::TEXT, count) == 2);
+    check("checked frame duplicate counted",
+          duplicate.stats().Duplicates == 1 && duplicate.stats().Lost == 0 && duplicate.stats().Valid == 3);
+
+    FrameChecker reordered;
+    check("checked frame reordered dropped", reordered.forEach(checkedBatch({10, 12, 11, 13}), WireFormat::TEXT, count) == 3);
+    check("checked frame reordered counted", reordered.stats().Reordered == 1 && reordered.stats().Lost == 1);
+
+    FrameChecker restarted;
+    check("checked frames after restart dispatched", restarted.forEach(checkedBatch({200, 100, 101}), WireFormat::TEXT, count) == 3);
+    check("checked frames after restart nothing lost", restarted.stats().Lost == 0);
+}
+
+/**
+ * @brief Index the UIDs, each under a distinct fake sensor, and check all are found.
+ */
+static bool indexesAll(const std::vector<std::string> &uids) {
+    SensorIndex index;
+    std::vector<char> sensors(uids.size());
+    for(size_t i = 0; i < uids.size(); ++i) {
+        if(!index.insert(uids[i], reinterpret_cast<BaseSensor*>(&sensors[i]))) {
+            return false;
+        }
+    }
+    for(size_t i = 0; i < uids.size(); ++i) {
+        if(index.find(uids[i]) != reinterpret_cast<BaseSensor*>(&sensors[i])) {
+            return false;
+        }
+    }
+    return index.size() == uids.size();
+}
+
+static void testSensorIndex() {
+    std::vector<std::string> sequential;
+    std::vector<std::string> strided;
+    std::vector<std::string> names;
+    for(int i = 0; i < 100; ++i) {
+        sequential.push_back(std::to_string(i));
+        strided.push_back(std::to_string(i * 256)); // Equal modulo every table size up to 256.
+        names.push_back("sensor-" + std::to_string(i));
+    }
+    check("index sequential ids", indexesAll(sequential));
+    check("index ids equal modulo the table size", indexesAll(strided));
+    check("index non-numeric uids", indexesAll(names));
+
+    SensorIndex index;
+    char a = 0;
+    char b = 0;
+    index.insert("8", reinterpret_cast<BaseSensor*>(&a));
+    index.insert("08", reinterpret_cast<BaseSensor*>(&b));
+    check("index numeric uid found by value", index.find(8u) == reinterpret_cast<BaseSensor*>(&a));
+    check("index non-canonical uid kept apart", index.find("08") == reinterpret_cast<BaseSensor*>(&b));
+    check("index duplicate uid rejected", !index.insert("8", reinterpret_cast<BaseSensor*>(&b)));
+    check("index missing uid not found", index.find("9") == nullptr && index.find(256u) == nullptr);
+
+    // Grown from 16 slots past 1024, every sensor is found again after each growth.
+    std::vector<std::string> grown;
+    for(int i = 0; i < 600; ++i) {
+        grown.push_back(i % 2 == 0 ? std::to_string(i * 1024) : "uid" + std::to_string(i));
+    }
+    check("index growth keeps all sensors", indexesAll(grown));
+    index.clear();
+    check("index cleared", index.size() == 0 && index.find("8") == nullptr);
+}
+
+static void testSampleScheduler() {
+    SampleScheduler schedule;
+    for(size_t i = 0; i < 4; ++i) {
+        schedule.add(i, 1000 + 100 * i);
+    }
+    check("scheduler reschedules a scheduled sensor", schedule.reschedule(3, 50));
+    check("scheduler rejects an unscheduled sensor", !schedule.reschedule(7, 50));
+
+    size_t id = 0;
+    unsigned long dueMs = 0;
+    check("scheduler rescheduled sensor due first", schedule.pop(60, id, dueMs) && id == 3 && dueMs == 50);
+    check("scheduler other sensors not due yet", !schedule.pop(60, id, dueMs) && schedule.size() == 3);
+    bool kept = true;
+    for(size_t i = 0; i < 3; ++i) {
+        kept = kept && schedule.pop(2000, id, dueMs) && id == i && dueMs == 1000 + 100 * i;
+    }
+    check("scheduler other sensors keep their deadlines", kept);
+}
+
+int main() {
+    testFormatNumber();
+    testDeltaFrames();
+    testDeltaListedRequests();
+    testRepeatedKeys();
+    testFrameSplitting();
+    testFrameCheck();
+    testSensorIndex();
+    testSampleScheduler();
+
+    printf("%s\n", failures == 0 ? "All checks passed." : "Some checks FAILED!");
+    return failures == 0 ? 0 : 1;
+}
@@ -9,6 +9,7 @@
 #include <ui.h>
 #include "config.hpp"
 #include "manager.hpp"
+#include "transport.hpp"
 
 /*Don't forget to set Sketchbook location in File/Preferences to the path of your UI project (the parent foder of this INO file)*/
 
@@ -147,6 +148,13 @@ void my_touchpad_read (lv_indev_drv_t * indev_driver, lv_indev_data_t * data)
 }
 
 SensorManager Manager = SensorManager();
+#if UART2_BUS
+HardwareSerial UART2(UART2_PORT);
+SerialTransport Uart2Transport(UART2, UART2_BAUDRATE, SERIAL_8N1, UART2_TX, UART2_RX);
+#endif
+#if USB_CDC_BUS
+StreamTransport UsbTransport(Serial);
+#endif
 void setup ()
 {
     Serial.begin( 115200 ); /* prepare for possible serial debug */
@@ -187,29 +195,31 @@ void setup ()
 
     ui_init();
     //lcd.fillScreen(TFT_BLACK);
+#if UART2_BUS
+    Manager.addBus(&Uart2Transport);
+#endif
+#if USB_CDC_BUS
+    Manager.addBus(&UsbTransport);
+#endif
     Manager.init(false);
     Manager.print();
 
     Manager.reconstruct();
+#if THREADED_SYNC
+    Manager.startThreaded(); // The buses are synchronized on the other core from now on.
+#endif
 
     Serial.println( "Setup done" );
 }
 
 const int FPS = 60;
 const int CYCLE_DRAW_MS = (1000/FPS);
-const int CYCLE_SYNC_MS = 100;
-
-const int LOOP_SYNC_TH = CYCLE_SYNC_MS/CYCLE_DRAW_MS;
-int LOOP_SYNC_COUNTER = LOOP_SYNC_TH;
 
 void loop ()
 {
-    if( LOOP_SYNC_COUNTER-- < 0)
-    {
-      Manager.resync();
-      LOOP_SYNC_COUNTER = LOOP_SYNC_TH;
-      delay(10);
-    }
+    // Requests only the sensors due by their sample period (or ingests the pushed frames),
+    // never waits for the replies.
+    Manager.resync();
     Manager.redraw();
     lv_timer_handler(); /* let the GUI do its work */
     delay(CYCLE_DRAW_MS);